@@ -38,6 +38,25 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
 #include <string.h> // CBC mode, for memset
 #include "aes.h"
 
+
+#if ((defined(GCM) && (GCM == 1)) || (defined(GCM_SIV) && (GCM_SIV == 1)) || (defined(HCTR2) && (HCTR2 == 1))) && \
+    GHASH_PCLMUL
+  #include <wmmintrin.h>
+#endif
+
+#if ((defined(ROUNDS) && (ROUNDS == 1)) || (defined(AEGIS) && (AEGIS == 1)) || (defined(HARAKA) && (HARAKA == 1))) && \
+    AES_ROUND_AESNI
+  #include <wmmintrin.h>
+#endif
+
+#if CTR_NONTEMPORAL
+  #include <emmintrin.h>
+#endif
+
+#if defined(DRBG) && (DRBG == 1) && DRBG_FORK_DETECT
+  #include <unistd.h> // DRBG fork detection, for getpid
+#endif
+
 /*****************************************************************************/
 /* Defines:                                                                  */
 /*****************************************************************************/
@@ -106,6 +125,80 @@ NOTE:   String length must be evenly divisible by 16byte (str_len % 16 == 0)
   #define MULTIPLY_AS_A_FUNCTION 0
 #endif
 
+// The multi-block functions interleave the rounds of up to AES_LANES independent blocks.
+// Keeping several blocks in flight lets the CPU overlap their S-box lookups instead of
+// waiting on the dependency chain of a single block. Set to 1 to minimize stack usage.
+#ifndef AES_LANES
+  #define AES_LANES 4
+#endif
+
+// The decryption direction of the block cipher is only compiled in for the modes that use it.
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1) || (defined(OCB) && OCB == 1) || \
+    (defined(XTS) && XTS == 1) || (defined(KW) && KW == 1) || (defined(HCTR2) && HCTR2 == 1) || \
+    ((defined(ROUNDS) && ROUNDS == 1) && !AES_ROUND_AESNI)
+  #define INV_CIPHER 1
+#else
+  #define INV_CIPHER 0
+#endif
+
+// Single-block encryption is used by the modes that chain their blocks or encrypt a lone block.
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1) || (defined(GCM) && GCM == 1) || \
+    (defined(CCM) && CCM == 1) || (defined(OCB) && OCB == 1) || (defined(CFB) && CFB == 1) || \
+    (defined(OFB) && OFB == 1) || (defined(CMAC) && CMAC == 1) || (defined(GCM_SIV) && GCM_SIV == 1) || \
+    (defined(SIV) && SIV == 1) || (defined(EAX) && EAX == 1) || (defined(DRBG) && DRBG == 1) || \
+    (defined(HCTR2) && HCTR2 == 1)
+  #define CIPHER_SINGLE 1
+#else
+  #define CIPHER_SINGLE 0
+#endif
+
+// Multi-block encryption is used by every mode except CBC and OFB, whose blocks depend on each other.
+#if (defined(ECB) && ECB == 1) || (defined(CTR) && CTR == 1) || (defined(GCM) && GCM == 1) || \
+    (defined(CCM) && CCM == 1) || (defined(OCB) && OCB == 1) || (defined(XTS) && XTS == 1) || \
+    (defined(CFB) && CFB == 1) || (defined(CMAC) && CMAC == 1) || (defined(GCM_SIV) && GCM_SIV == 1) || \
+    (defined(SIV) && SIV == 1) || (defined(KW) && KW == 1) || (defined(EAX) && EAX == 1) || \
+    (defined(DRBG) && DRBG == 1) || (defined(FPE) && FPE == 1) || (defined(CRHASH) && CRHASH == 1) || \
+    (defined(HCTR2) && HCTR2 == 1)
+  #define CIPHER_BLOCKS 1
+#else
+  #define CIPHER_BLOCKS 0
+#endif
+
+// The CMAC chains are shared by CMAC, SIV whose S2V is built on CMAC, and EAX whose OMAC is CMAC.
+#if (defined(CMAC) && CMAC == 1) || (defined(SIV) && SIV == 1) || (defined(EAX) && EAX == 1)
+  #define OMAC 1
+#else
+  #define OMAC 0
+#endif
+
+// 128 bit blocks with an AES round operation, in AES-NI registers or portable, for the constructions made of AES rounds.
+#if (defined(AEGIS) && AEGIS == 1) || (defined(HARAKA) && HARAKA == 1)
+  #define ROUND_BLOCKS 1
+#else
+  #define ROUND_BLOCKS 0
+#endif
+
+// The forward round functions serve the cipher, MMO with its per-block key schedule, and the portable AES rounds.
+#if CIPHER_SINGLE || CIPHER_BLOCKS || (defined(MMO) && MMO == 1) || \
+    ((ROUND_BLOCKS || (defined(ROUNDS) && ROUNDS == 1)) && !AES_ROUND_AESNI)
+  #define CIPHER_ROUNDS 1
+#else
+  #define CIPHER_ROUNDS 0
+#endif
+
+// The GHASH multipliers are shared by GCM, GCM-SIV and HCTR2, whose POLYVAL is GHASH on byte-reversed blocks.
+#if (defined(GCM) && GCM == 1) || (defined(GCM_SIV) && GCM_SIV == 1) || (defined(HCTR2) && HCTR2 == 1)
+  #define GHASH 1
+#else
+  #define GHASH 0
+#endif
+
+#if (defined(GCM_SIV) && GCM_SIV == 1) || (defined(HCTR2) && HCTR2 == 1)
+  #define POLYVAL 1
+#else
+  #define POLYVAL 0
+#endif
+
 
 
 
@@ -145,7 +238,7 @@ static const uint8_t sbox[256] PROGMEM = {
   0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
   0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16 };
 
-#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+#if INV_CIPHER
 static const uint8_t rsbox[256] PROGMEM = {
   0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
   0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
@@ -255,12 +348,19 @@ static void KeyExpansion(roundKey_t* RoundKey, const uint8_t* Key)
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key)
 {
   KeyExpansion(ctx->RoundKey, key);
+#if defined(CTR) && (CTR == 1)
+  ctx->CtrLen = AES_BLOCKLEN;
+#endif
 }
-#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
+#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1)) || \
+    (defined(CFB) && (CFB == 1)) || (defined(OFB) && (OFB == 1))
 void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv)
 {
   KeyExpansion(ctx->RoundKey, key);
   memcpy (ctx->Iv, iv, AES_BLOCKLEN);
+#if defined(CTR) && (CTR == 1)
+  ctx->CtrLen = AES_BLOCKLEN;
+#endif
 }
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
 {
@@ -268,6 +368,7 @@ void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
 }
 #endif
 
+#if CIPHER_SINGLE || CIPHER_BLOCKS
 // This function adds the round key to state.
 // The round key is added to the state by an XOR function.
 static void AddRoundKey(uint8_t round, state_t* state, const roundKey_t* RoundKey)
@@ -278,7 +379,9 @@ static void AddRoundKey(uint8_t round, state_t* state, const roundKey_t* RoundKe
     (*state).i[i] ^= RoundKey->i[(round * Nb) + i];
   }
 }
+#endif // #if CIPHER_SINGLE || CIPHER_BLOCKS
 
+#if CIPHER_ROUNDS
 // The SubBytes Function Substitutes the values in the
 // state matrix with values in an S-box.
 static void SubBytes(state_t* state)
@@ -345,12 +448,14 @@ static void ShiftRows(state_t* state)
   (*state).i[2] = line2;
   (*state).i[3] = line3;
 }
+#endif // #if CIPHER_ROUNDS
 
 static inline uint32_t xtime(uint32_t x)
 {
   return ((x&0x7f7f7f7f)<<1)^(((x&0x80808080)>>7)*0x1b);
 }
 
+#if CIPHER_ROUNDS
 // MixColumns function mixes the columns of the state matrix
 static void MixColumns(state_t* state)
 {
@@ -362,6 +467,7 @@ static void MixColumns(state_t* state)
             (((sp)<<16)|((sp)>>16)) ^ (((sp)<<24)|((sp)>>8));
   }
 }
+#endif // #if CIPHER_ROUNDS
 
 // Multiply is used to multiply numbers in the field GF(2^8)
 // Note: The last call to xtime() is unneeded, but often ends up generating a smaller binary
@@ -384,7 +490,7 @@ static inline uint32_t Multiply(uint32_t x, uint32_t y)
 #endif
     ); /* this last call to xtime() can be omitted */
 }
-#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+#if INV_CIPHER
 /*
 static uint8_t getSBoxInvert(uint8_t num)
 {
@@ -496,8 +602,9 @@ static void InvShiftRows(state_t* state)
   (*state).i[2] = line2;
   (*state).i[3] = line3;
 }
-#endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+#endif // #if INV_CIPHER
 
+#if CIPHER_SINGLE
 // Cipher is the main function that encrypts the PlainText.
 static void Cipher(state_t* state, const roundKey_t* RoundKey)
 {
@@ -523,8 +630,45 @@ static void Cipher(state_t* state, const roundKey_t* RoundKey)
   // Add round key to last round
   AddRoundKey(Nr, state, RoundKey);
 }
+#endif // #if CIPHER_SINGLE
+
+#if CIPHER_BLOCKS
+// Encrypts nblocks consecutive blocks in place, running the same round on each lane before moving on.
+static void CipherBlocks(state_t* state, size_t nblocks, const roundKey_t* RoundKey)
+{
+  uint8_t round;
+  size_t i, n;
+
+  for (; nblocks > 0; nblocks -= n, state += n)
+  {
+    n = (nblocks < AES_LANES) ? nblocks : AES_LANES;
+
+    for (i = 0; i < n; ++i)
+    {
+      AddRoundKey(0, &state[i], RoundKey);
+    }
+    for (round = 1; round < Nr; ++round)
+    {
+      for (i = 0; i < n; ++i)
+      {
+        SubBytes(&state[i]);
+        ShiftRows(&state[i]);
+        MixColumns(&state[i]);
+        AddRoundKey(round, &state[i], RoundKey);
+      }
+    }
+    for (i = 0; i < n; ++i)
+    {
+      SubBytes(&state[i]);
+      ShiftRows(&state[i]);
+      AddRoundKey(Nr, &state[i], RoundKey);
+    }
+  }
+}
+#endif // #if CIPHER_BLOCKS
 
-#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+
+#if (defined(ECB) && ECB == 1) || (defined(CBC) && CBC == 1) || (defined(HCTR2) && HCTR2 == 1)
 static void InvCipher(state_t* state, const roundKey_t* RoundKey)
 {
   uint8_t round = 0;
@@ -548,7 +692,225 @@ static void InvCipher(state_t* state, const roundKey_t* RoundKey)
   }
 
 }
-#endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+#endif // #if (defined(ECB) && ECB == 1) || (defined(CBC) && CBC == 1) || (defined(HCTR2) && HCTR2 == 1)
+
+#if (defined(ECB) && ECB == 1) || (defined(OCB) && OCB == 1) || (defined(XTS) && XTS == 1) || \
+    (defined(KW) && KW == 1)
+// Decrypts nblocks consecutive blocks in place, interleaved the same way as CipherBlocks().
+static void InvCipherBlocks(state_t* state, size_t nblocks, const roundKey_t* RoundKey)
+{
+  uint8_t round;
+  size_t i, n;
+
+  for (; nblocks > 0; nblocks -= n, state += n)
+  {
+    n = (nblocks < AES_LANES) ? nblocks : AES_LANES;
+
+    for (i = 0; i < n; ++i)
+    {
+      AddRoundKey(Nr, &state[i], RoundKey);
+    }
+    for (round = (Nr - 1); round > 0; --round)
+    {
+      for (i = 0; i < n; ++i)
+      {
+        InvShiftRows(&state[i]);
+        InvSubBytes(&state[i]);
+        AddRoundKey(round, &state[i], RoundKey);
+        InvMixColumns(&state[i]);
+      }
+    }
+    for (i = 0; i < n; ++i)
+    {
+      InvShiftRows(&state[i]);
+      InvSubBytes(&state[i]);
+      AddRoundKey(0, &state[i], RoundKey);
+    }
+  }
+}
+#endif // #if (defined(ECB) && ECB == 1) || (defined(OCB) && OCB == 1) || (defined(XTS) && XTS == 1) || (defined(KW) && KW == 1)
+
+#if (defined(CTR) && CTR == 1) || (defined(GCM) && GCM == 1) || (defined(CCM) && CCM == 1) || \
+    (defined(SIV) && SIV == 1) || (defined(EAX) && EAX == 1) || (defined(DRBG) && DRBG == 1)
+/* Increments the big-endian counter held in the last 'len' bytes of Iv, wrapping around within that field */
+static void IncrementCounter(uint8_t* Iv, uint8_t len)
+{
+  uint8_t bi;
+  for (bi = AES_BLOCKLEN; bi > (AES_BLOCKLEN - len); --bi)
+  {
+    /* inc will overflow, carry into the next byte */
+    if (++Iv[bi - 1] != 0)
+    {
+      break;
+    }
+  }
+}
+#endif // #if (defined(CTR) && CTR == 1) || (defined(GCM) && GCM == 1) || (defined(CCM) && CCM == 1) || (defined(SIV) && SIV == 1) || (defined(EAX) && EAX == 1) || (defined(DRBG) && DRBG == 1)
+
+#if (defined(CTR) && CTR == 1) || (defined(GCM) && GCM == 1) || (defined(DRBG) && DRBG == 1)
+// How CtrStream() applies the keystream to buf
+#define CTR_XOR      0 // buf ^= keystream
+#define CTR_STORE    1 // buf = keystream, buf is not read
+#define CTR_STORE_NT 2 // as CTR_STORE, with non-temporal stores for the aligned blocks if CTR_NONTEMPORAL is enabled
+
+// Applies the keystream E(Iv), E(Iv+1), ... to buf, generating AES_LANES keystream blocks per CipherBlocks() call.
+// Iv is left at the first counter not used, a trailing partial block consumes a whole counter.
+static void CtrStream(const roundKey_t* RoundKey, uint8_t* Iv, uint8_t CtrLen, uint8_t* buf, size_t length, uint8_t mode)
+{
+  state_t stream[AES_LANES];
+  size_t i, n, len;
+
+  while (length > 0)
+  {
+    for (n = 0; (n < AES_LANES) && (n * AES_BLOCKLEN < length); ++n)
+    {
+      memcpy(&stream[n], Iv, AES_BLOCKLEN);
+      IncrementCounter(Iv, CtrLen);
+    }
+    CipherBlocks(stream, n, RoundKey);
+
+    len = (length < n * AES_BLOCKLEN) ? length : n * AES_BLOCKLEN;
+    if (mode == CTR_XOR)
+    {
+      for (i = 0; i < len; ++i)
+      {
+        buf[i] ^= ((const uint8_t*)stream)[i];
+      }
+    }
+#if CTR_NONTEMPORAL
+    else if ((mode == CTR_STORE_NT) && (len == n * AES_BLOCKLEN) && (((uintptr_t)buf & (AES_BLOCKLEN - 1)) == 0))
+    {
+      for (i = 0; i < n; ++i)
+      {
+        _mm_stream_si128((__m128i*)buf + i, _mm_loadu_si128((const __m128i*)&stream[i]));
+      }
+    }
+#endif
+    else
+    {
+      memcpy(buf, stream, len);
+    }
+    buf += len;
+    length -= len;
+  }
+#if CTR_NONTEMPORAL
+  if (mode == CTR_STORE_NT)
+  {
+    _mm_sfence(); // make the streamed stores visible in order with the stores that follow
+  }
+#endif
+}
+#endif // #if (defined(CTR) && CTR == 1) || (defined(GCM) && GCM == 1) || (defined(DRBG) && DRBG == 1)
+
+// Returns non-zero if the first len bytes differ. Runs in constant time so a forger learns nothing from the timing.
+static inline uint8_t TagsDiffer(const uint8_t* a, const uint8_t* b, size_t len)
+{
+  uint8_t diff = 0;
+  size_t i;
+  for (i = 0; i < len; ++i)
+  {
+    diff |= a[i] ^ b[i];
+  }
+  return diff;
+}
+
+static inline void XorBlock(uint8_t* buf, const uint8_t* x)
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    buf[i] ^= x[i];
+  }
+}
+
+// Multiplies a big-endian block by x in GF(2^128) modulo x^128 + x^7 + x^2 + x + 1 ("doubling")
+static inline void DoubleBlock(uint8_t* out, const uint8_t* in)
+{
+  uint8_t i, carry = (uint8_t)(0 - (in[0] >> 7));
+  for (i = 0; i < AES_BLOCKLEN - 1; ++i)
+  {
+    out[i] = (uint8_t)((in[i] << 1) | (in[i + 1] >> 7));
+  }
+  out[AES_BLOCKLEN - 1] = (uint8_t)((in[AES_BLOCKLEN - 1] << 1) ^ (carry & 0x87));
+}
+
+#if ROUND_BLOCKS
+#if AES_ROUND_AESNI
+typedef __m128i block_t;
+
+#define LoadBlock(p)     _mm_loadu_si128((const __m128i*)(p))
+#define StoreBlock(p, b) _mm_storeu_si128((__m128i*)(p), (b))
+#define RoundBlock(b, k) _mm_aesenc_si128((b), (k))
+#define XorBlocks(a, b)  _mm_xor_si128((a), (b))
+#define AndBlocks(a, b)  _mm_and_si128((a), (b))
+#define UnpackLo(a, b)   _mm_unpacklo_epi32((a), (b))
+#define UnpackHi(a, b)   _mm_unpackhi_epi32((a), (b))
+#else
+typedef state_t block_t;
+
+static inline block_t LoadBlock(const uint8_t* p)
+{
+  block_t b;
+  memcpy(&b, p, AES_BLOCKLEN);
+  return b;
+}
+
+static inline void StoreBlock(uint8_t* p, block_t b)
+{
+  memcpy(p, &b, AES_BLOCKLEN);
+}
+
+static inline block_t XorBlocks(block_t a, block_t b)
+{
+  uint8_t i;
+  for (i = 0; i < 4; ++i)
+  {
+    a.i[i] ^= b.i[i];
+  }
+  return a;
+}
+
+static inline block_t AndBlocks(block_t a, block_t b)
+{
+  uint8_t i;
+  for (i = 0; i < 4; ++i)
+  {
+    a.i[i] &= b.i[i];
+  }
+  return a;
+}
+
+// Interleave the 32 bit words of the low or the high halves of a and b, as PUNPCKLDQ and PUNPCKHDQ
+static inline block_t UnpackLo(block_t a, block_t b)
+{
+  block_t r;
+  r.i[0] = a.i[0];
+  r.i[1] = b.i[0];
+  r.i[2] = a.i[1];
+  r.i[3] = b.i[1];
+  return r;
+}
+
+static inline block_t UnpackHi(block_t a, block_t b)
+{
+  block_t r;
+  r.i[0] = a.i[2];
+  r.i[1] = b.i[2];
+  r.i[2] = a.i[3];
+  r.i[3] = b.i[3];
+  return r;
+}
+
+// One AES encryption round with round key k, as AESENC
+static inline block_t RoundBlock(block_t b, block_t k)
+{
+  SubBytes(&b);
+  ShiftRows(&b);
+  MixColumns(&b);
+  return XorBlocks(b, k);
+}
+#endif // #if AES_ROUND_AESNI
+#endif // #if ROUND_BLOCKS
 
 /*****************************************************************************/
 /* Public functions:                                                         */
@@ -568,6 +930,15 @@ void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf)
   InvCipher((state_t*)buf, ctx->RoundKey);
 }
 
+void AES_ECB_encrypt_buffer(const struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  CipherBlocks((state_t*)buf, length / AES_BLOCKLEN, ctx->RoundKey);
+}
+
+void AES_ECB_decrypt_buffer(const struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  InvCipherBlocks((state_t*)buf, length / AES_BLOCKLEN, ctx->RoundKey);
+}
 
 #endif // #if defined(ECB) && (ECB == 1)
 
@@ -617,45 +988,3931 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
 
 }
 
+size_t AES_CBC_PKCS7_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  uint8_t pad = (uint8_t)(AES_BLOCKLEN - length % AES_BLOCKLEN);
+
+  memset(buf + length, pad, pad);
+  AES_CBC_encrypt_buffer(ctx, buf, length + pad);
+  return length + pad;
+}
+
+// Returns the pad length given by the last block, or 0 if the padding is malformed. All of the block is checked
+// without branching on its contents, so the timing tells a padding oracle nothing about where the padding broke.
+static uint8_t Pkcs7Check(const uint8_t* block)
+{
+  uint32_t pad = block[AES_BLOCKLEN - 1];
+  uint32_t bad, mask;
+  uint8_t i;
+
+  bad = ((pad - 1) | (AES_BLOCKLEN - pad)) >> 8; // pad outside 1..AES_BLOCKLEN
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    mask = 0 - (((uint32_t)i - pad) >> 31);      // all ones for the pad bytes
+    bad |= (block[AES_BLOCKLEN - 1 - i] ^ pad) & mask;
+  }
+  return (uint8_t)(pad & (((0 - bad) >> 31) - 1));
+}
+
+int AES_CBC_PKCS7_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length, size_t* out_len)
+{
+  uint8_t pad = 0;
+
+  if ((length != 0) && (length % AES_BLOCKLEN == 0))
+  {
+    AES_CBC_decrypt_buffer(ctx, buf, length);
+    pad = Pkcs7Check(buf + length - AES_BLOCKLEN);
+  }
+  if (pad == 0)
+  {
+    memset(buf, 0, length);
+    *out_len = 0;
+    return 1;
+  }
+  *out_len = length - pad;
+  return 0;
+}
+
+// CBC-CS3 (NIST SP 800-38A addendum): the last block is zero padded and encrypted in CBC mode, and the last two
+// ciphertext blocks are swapped, the former second-to-last one being truncated to the length of the last.
+void AES_CBC_CS3_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  size_t n = (length - 1) / AES_BLOCKLEN * AES_BLOCKLEN; // bytes before the last, possibly partial, block
+  uint8_t* last = buf + n;
+  uint8_t* prev;
+  uint8_t C[AES_BLOCKLEN];
+  uint8_t i, d = (uint8_t)(length - n);
+
+  if (length < AES_BLOCKLEN)
+  {
+    return;
+  }
+  if (n == 0)
+  {
+    AES_CBC_encrypt_buffer(ctx, buf, AES_BLOCKLEN);
+    return;
+  }
+  AES_CBC_encrypt_buffer(ctx, buf, n);
+  prev = last - AES_BLOCKLEN;
+  memcpy(C, prev, AES_BLOCKLEN);
+  for (i = 0; i < d; ++i)
+  {
+    C[i] ^= last[i];
+  }
+  Cipher((state_t*)C, ctx->RoundKey);
+  memcpy(last, prev, d);
+  memcpy(prev, C, AES_BLOCKLEN);
+}
+
+void AES_CBC_CS3_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  size_t n = (length - 1) / AES_BLOCKLEN * AES_BLOCKLEN;
+  uint8_t* last = buf + n;
+  uint8_t* prev;
+  uint8_t C[AES_BLOCKLEN];
+  uint8_t D[AES_BLOCKLEN];
+  uint8_t i, d = (uint8_t)(length - n);
+
+  if (length < AES_BLOCKLEN)
+  {
+    return;
+  }
+  if (n == 0)
+  {
+    AES_CBC_decrypt_buffer(ctx, buf, AES_BLOCKLEN);
+    return;
+  }
+  prev = last - AES_BLOCKLEN;
+  AES_CBC_decrypt_buffer(ctx, buf, n - AES_BLOCKLEN);
+
+  // The full block decrypts to D = C ^ (last || 0), C being the truncated block, so D holds the missing tail of C
+  memcpy(D, prev, AES_BLOCKLEN);
+  InvCipher((state_t*)D, ctx->RoundKey);
+  memcpy(C, last, d);
+  memcpy(C + d, D + d, AES_BLOCKLEN - d);
+  for (i = 0; i < d; ++i)
+  {
+    last[i] = C[i] ^ D[i];
+  }
+  memcpy(prev, C, AES_BLOCKLEN);
+  InvCipher((state_t*)prev, ctx->RoundKey);
+  XorWithIv(prev, ctx->Iv);
+}
+
 #endif // #if defined(CBC) && (CBC == 1)
 
 
 
 #if defined(CTR) && (CTR == 1)
 
+void AES_ctx_set_counter_width(struct AES_ctx* ctx, unsigned bits)
+{
+  if ((bits == AES_CTR_WIDTH_32) || (bits == AES_CTR_WIDTH_64) || (bits == AES_CTR_WIDTH_128))
+  {
+    ctx->CtrLen = (uint8_t)(bits / 8);
+  }
+}
+
 /* Symmetrical operation: same function for encrypting as for decrypting. Note any IV/nonce should never be reused with the same key */
 void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
 {
-  uint8_t buffer[AES_BLOCKLEN];
-  
-  size_t i;
-  int bi;
-  for (i = 0, bi = AES_BLOCKLEN; i < length; ++i, ++bi)
+  CtrStream(ctx->RoundKey, ctx->Iv, ctx->CtrLen, buf, length, CTR_XOR);
+}
+
+void AES_CTR_keystream_buffer(struct AES_ctx* ctx, uint8_t* out, size_t length)
+{
+  CtrStream(ctx->RoundKey, ctx->Iv, ctx->CtrLen, out, length, CTR_STORE_NT);
+}
+
+#endif // #if defined(CTR) && (CTR == 1)
+
+
+
+#if GHASH
+
+// GCM processes this many blocks per CTR/GHASH step.
+// The carry-less multipliers fold them into the hash with a single reduction, using the powers H^4..H^1.
+#define GHASH_STRIDE 4
+
+static uint64_t GetBE64(const uint8_t* p)
+{
+  uint64_t v = 0;
+  uint8_t i;
+  for (i = 0; i < 8; ++i)
+  {
+    v = (v << 8) | p[i];
+  }
+  return v;
+}
+
+static void PutBE64(uint8_t* p, uint64_t v)
+{
+  uint8_t i;
+  for (i = 8; i > 0; --i)
+  {
+    p[i - 1] = (uint8_t)v;
+    v >>= 8;
+  }
+}
+
+#if GHASH_TABLE
+
+// Reduction of the four bits shifted out of the product in each step of the 4-bit method
+static const uint16_t last4[16] = {
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0 };
+
+// Precomputes the products of H with all 4-bit values (Shoup's method)
+static void GhashInit(ghashKey_t* key, const uint8_t* h)
+{
+  uint64_t vh = GetBE64(h);
+  uint64_t vl = GetBE64(h + 8);
+  uint8_t i, j;
+
+  key->table.hi[0] = 0;
+  key->table.lo[0] = 0;
+  key->table.hi[8] = vh;
+  key->table.lo[8] = vl;
+  for (i = 4; i > 0; i >>= 1)
+  {
+    uint64_t T = (uint64_t)0 - (vl & 1);
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ (T & 0xe100000000000000);
+    key->table.hi[i] = vh;
+    key->table.lo[i] = vl;
+  }
+  for (i = 2; i <= 8; i <<= 1)
   {
-    if (bi == AES_BLOCKLEN) /* we need to regen xor compliment in buffer */
+    for (j = 1; j < i; ++j)
     {
-      
-      memcpy(buffer, ctx->Iv, AES_BLOCKLEN);
-      Cipher((state_t*)buffer,ctx->RoundKey);
+      key->table.hi[i + j] = key->table.hi[i] ^ key->table.hi[j];
+      key->table.lo[i + j] = key->table.lo[i] ^ key->table.lo[j];
+    }
+  }
+}
 
-      /* Increment Iv and handle overflow */
-      for (bi = (AES_BLOCKLEN - 1); bi >= 0; --bi)
-      {
-	/* inc will overflow */
-        if (ctx->Iv[bi] == 255)
-	{
-          ctx->Iv[bi] = 0;
-          continue;
-        } 
-        ctx->Iv[bi] += 1;
-        break;   
-      }
-      bi = 0;
+// Multiplies X by H four bits at a time, starting from the last byte
+static void GhashMul(const ghashKey_t* key, uint64_t X[2])
+{
+  uint64_t zh = 0, zl = 0;
+  uint8_t i, x, nibble, rem;
+
+  for (i = AES_BLOCKLEN; i > 0; --i)
+  {
+    x = (uint8_t)(X[(i - 1) / 8] >> (8 * ((AES_BLOCKLEN - i) % 8)));
+    for (nibble = 0; nibble < 2; ++nibble)
+    {
+      rem = (uint8_t)(zl & 0xf);
+      zl = (zh << 60) | (zl >> 4);
+      zh = (zh >> 4) ^ ((uint64_t)last4[rem] << 48);
+      zh ^= key->table.hi[x & 0xf];
+      zl ^= key->table.lo[x & 0xf];
+      x >>= 4;
     }
+  }
+  X[0] = zh;
+  X[1] = zl;
+}
 
-    buf[i] = (buf[i] ^ buffer[bi]);
+// Hashes nblocks full blocks into X
+static void GhashBlocks(const ghashKey_t* key, uint64_t X[2], const uint8_t* data, size_t nblocks)
+{
+  for (; nblocks > 0; --nblocks, data += AES_BLOCKLEN)
+  {
+    X[0] ^= GetBE64(data);
+    X[1] ^= GetBE64(data + 8);
+    GhashMul(key, X);
   }
 }
 
-#endif // #if defined(CTR) && (CTR == 1)
+#else // #if GHASH_TABLE
+
+// Carry-less multiplication of two 64 bit polynomials, giving a 128 bit product.
+#if GHASH_PCLMUL
+static void Clmul64(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo)
+{
+  __m128i r = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a), _mm_cvtsi64_si128((long long)b), 0x00);
+  *lo = (uint64_t)_mm_cvtsi128_si64(r);
+  *hi = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(r, r));
+}
+#else
+// Bit-serial version without secret dependent branches or table lookups, so it runs in constant time.
+static void Clmul64(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo)
+{
+  uint64_t h = 0, l = 0, mask;
+  uint8_t i;
+  for (i = 0; i < 64; ++i)
+  {
+    mask = (uint64_t)0 - ((b >> i) & 1);
+    l ^= (a << i) & mask;
+    if (i != 0)
+    {
+      h ^= (a >> (64 - i)) & mask;
+    }
+  }
+  *hi = h;
+  *lo = l;
+}
+#endif
+
+// GHASH elements are kept bit-reflected: a block loaded big-endian as { high, low } 64 bit words.
+// In that form the carry-less product of two elements comes out shifted by one bit. The hash subkey powers
+// are therefore stored multiplied by x^-1 (a left shift, folding the carry back in with 0xC2...01),
+// which cancels the shift and lets GhashReduce() work directly on the product.
+static void GhashTwist(uint64_t t[2], const uint64_t h[2])
+{
+  uint64_t carry = (uint64_t)0 - (h[0] >> 63);
+  t[0] = ((h[0] << 1) | (h[1] >> 63)) ^ (carry & 0xC200000000000000);
+  t[1] = (h[1] << 1) ^ (carry & 1);
+}
+
+// Adds the unreduced 256 bit product x * h to acc, as the Karatsuba terms { hi*hi, lo*lo, middle }.
+// Products of several blocks can be summed up this way and reduced only once.
+static void GhashMulAcc(uint64_t acc[6], const uint64_t x[2], const uint64_t h[2])
+{
+  uint64_t hi, lo;
+
+  Clmul64(x[0], h[0], &hi, &lo);
+  acc[0] ^= hi;
+  acc[1] ^= lo;
+  Clmul64(x[1], h[1], &hi, &lo);
+  acc[2] ^= hi;
+  acc[3] ^= lo;
+  Clmul64(x[0] ^ x[1], h[0] ^ h[1], &hi, &lo);
+  acc[4] ^= hi;
+  acc[5] ^= lo;
+}
+
+// Reduces the accumulated product modulo x^128 + x^7 + x^2 + x + 1.
+static void GhashReduce(uint64_t x[2], const uint64_t acc[6])
+{
+  uint64_t v3 = acc[0];
+  uint64_t v2 = acc[1] ^ acc[0] ^ acc[2] ^ acc[4];
+  uint64_t v1 = acc[2] ^ acc[1] ^ acc[3] ^ acc[5];
+  uint64_t v0 = acc[3];
+  uint64_t d = v1 ^ (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+
+  x[0] = v3 ^ d ^ (d >> 1) ^ (d >> 2) ^ (d >> 7);
+  x[1] = v2 ^ v0 ^ ((v0 >> 1) | (d << 63)) ^ ((v0 >> 2) | (d << 62)) ^ ((v0 >> 7) | (d << 57));
+}
+
+// Precomputes the powers H^1..H^GHASH_STRIDE
+static void GhashInit(ghashKey_t* key, const uint8_t* h)
+{
+  uint64_t p[2], acc[6];
+  uint8_t i;
+
+  p[0] = GetBE64(h);
+  p[1] = GetBE64(h + 8);
+  GhashTwist(key->pow[0], p);
+  for (i = 1; i < GHASH_STRIDE; ++i)
+  {
+    memset(acc, 0, sizeof(acc));
+    GhashMulAcc(acc, p, key->pow[0]);
+    GhashReduce(p, acc);
+    GhashTwist(key->pow[i], p);
+  }
+}
+
+// Hashes nblocks full blocks into X, reducing once per GHASH_STRIDE blocks:
+// X = (X ^ B1)*H^4 ^ B2*H^3 ^ B3*H^2 ^ B4*H
+static void GhashBlocks(const ghashKey_t* key, uint64_t X[2], const uint8_t* data, size_t nblocks)
+{
+  uint64_t acc[6], y[2];
+  size_t i, n;
+
+  for (; nblocks > 0; nblocks -= n)
+  {
+    n = (nblocks < GHASH_STRIDE) ? nblocks : GHASH_STRIDE;
+    memset(acc, 0, sizeof(acc));
+    for (i = 0; i < n; ++i, data += AES_BLOCKLEN)
+    {
+      y[0] = GetBE64(data);
+      y[1] = GetBE64(data + 8);
+      if (i == 0)
+      {
+        y[0] ^= X[0];
+        y[1] ^= X[1];
+      }
+      GhashMulAcc(acc, y, key->pow[n - 1 - i]);
+    }
+    GhashReduce(X, acc);
+  }
+}
+
+#endif // #if GHASH_TABLE
+
+#if defined(GCM) && (GCM == 1)
+
+// Hashes length bytes into X, zero-padding the final partial block.
+static void GhashPadded(const ghashKey_t* key, uint64_t X[2], const uint8_t* data, size_t length)
+{
+  uint8_t block[AES_BLOCKLEN] = { 0 };
+  size_t rem = length % AES_BLOCKLEN;
+
+  GhashBlocks(key, X, data, length / AES_BLOCKLEN);
+  if (rem != 0)
+  {
+    memcpy(block, data + length - rem, rem);
+    GhashBlocks(key, X, block, 1);
+  }
+}
+
+#endif // #if defined(GCM) && (GCM == 1)
+
+#endif // #if GHASH
+
+
+
+#if POLYVAL
+
+// POLYVAL(H, X_1, ..., X_n) equals GHASH(H * x, reversed X_1, ..., reversed X_n) with the result reversed
+// (RFC 8452, Appendix A). This lets GCM-SIV and HCTR2 run on whichever GHASH multiplier is compiled in.
+static void ReverseBlock(uint8_t* out, const uint8_t* in)
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    out[i] = in[AES_BLOCKLEN - 1 - i];
+  }
+}
+
+static void PolyvalInit(ghashKey_t* key, const uint8_t* h)
+{
+  uint8_t block[AES_BLOCKLEN];
+  uint64_t hi, lo, carry;
+
+  ReverseBlock(block, h);
+  hi = GetBE64(block);
+  lo = GetBE64(block + 8);
+  carry = (uint64_t)0 - (lo & 1);
+  lo = (lo >> 1) | (hi << 63);
+  hi = (hi >> 1) ^ (carry & 0xe100000000000000);
+  PutBE64(block, hi);
+  PutBE64(block + 8, lo);
+  GhashInit(key, block);
+}
+
+// Hashes length bytes into X, zero-padding the final partial block, GHASH_STRIDE blocks at a time
+static void PolyvalPadded(const ghashKey_t* key, uint64_t X[2], const uint8_t* data, size_t length)
+{
+  uint8_t block[AES_BLOCKLEN];
+  uint8_t reversed[GHASH_STRIDE * AES_BLOCKLEN];
+  size_t i, n;
+
+  while (length > 0)
+  {
+    for (n = 0; (n < GHASH_STRIDE) && (length > 0); ++n)
+    {
+      i = (length < AES_BLOCKLEN) ? length : AES_BLOCKLEN;
+      memset(block, 0, AES_BLOCKLEN);
+      memcpy(block, data, i);
+      ReverseBlock(reversed + n * AES_BLOCKLEN, block);
+      data += i;
+      length -= i;
+    }
+    GhashBlocks(key, X, reversed, n);
+  }
+}
+
+#endif // #if POLYVAL
+
+
+
+#if defined(GCM) && (GCM == 1)
+
+void AES_GCM_init_ctx(struct AES_GCM_ctx* ctx, const uint8_t* key)
+{
+  uint8_t h[AES_BLOCKLEN] = { 0 };
+
+  AES_init_ctx(&ctx->aes, key);
+  Cipher((state_t*)h, ctx->aes.RoundKey);
+  GhashInit(&ctx->H, h);
+}
+
+// SP 800-38D: tags are 12 to 16 bytes long, or 4 or 8 with GCM_SHORT_TAGS
+static uint8_t GcmTagLenValid(size_t tag_len)
+{
+  return ((tag_len >= 12) && (tag_len <= AES_BLOCKLEN)) || (GCM_SHORT_TAGS && ((tag_len == 4) || (tag_len == 8)));
+}
+
+// Derives the pre-counter block J0 from the IV
+static void GcmCounter0(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len, uint8_t* J0)
+{
+  uint8_t block[AES_BLOCKLEN] = { 0 };
+  uint64_t X[2] = { 0, 0 };
+
+  if (iv_len == 12)
+  {
+    memcpy(J0, iv, 12);
+    memset(J0 + 12, 0, 3);
+    J0[15] = 1;
+    return;
+  }
+  GhashPadded(&ctx->H, X, iv, iv_len);
+  PutBE64(block + 8, (uint64_t)iv_len * 8);
+  GhashBlocks(&ctx->H, X, block, 1);
+  PutBE64(J0, X[0]);
+  PutBE64(J0 + 8, X[1]);
+}
+
+// Encrypts or decrypts buf and computes the full 16 byte tag.
+// CTR and GHASH are stitched: each chunk of GHASH_STRIDE blocks is hashed right before (decrypt) or
+// right after (encrypt) its keystream is applied, while it is still in cache, so buf is only walked once.
+static void GcmCrypt(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                     uint8_t encrypt, uint8_t* tag)
+{
+  uint8_t J0[AES_BLOCKLEN], ctr[AES_BLOCKLEN], block[AES_BLOCKLEN];
+  uint64_t X[2] = { 0, 0 };
+  size_t i, n, clen = length;
+
+  GcmCounter0(ctx, iv, iv_len, J0);
+  memcpy(ctr, J0, AES_BLOCKLEN);
+  IncrementCounter(ctr, 4);
+
+  GhashPadded(&ctx->H, X, aad, aad_len);
+  for (; length > 0; length -= n, buf += n)
+  {
+    n = (length < GHASH_STRIDE * AES_BLOCKLEN) ? length : GHASH_STRIDE * AES_BLOCKLEN;
+    if (!encrypt)
+    {
+      GhashPadded(&ctx->H, X, buf, n);
+    }
+    CtrStream(ctx->aes.RoundKey, ctr, 4, buf, n, CTR_XOR);
+    if (encrypt)
+    {
+      GhashPadded(&ctx->H, X, buf, n);
+    }
+  }
+
+  PutBE64(block, (uint64_t)aad_len * 8);
+  PutBE64(block + 8, (uint64_t)clen * 8);
+  GhashBlocks(&ctx->H, X, block, 1);
+
+  PutBE64(tag, X[0]);
+  PutBE64(tag + 8, X[1]);
+  Cipher((state_t*)J0, ctx->aes.RoundKey);
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    tag[i] ^= J0[i];
+  }
+}
+
+void AES_GCM_encrypt_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if ((iv_len == 0) || !GcmTagLenValid(tag_len))
+  {
+    return;
+  }
+  GcmCrypt(ctx, iv, iv_len, aad, aad_len, buf, length, 1, full);
+  memcpy(tag, full, tag_len);
+}
+
+int AES_GCM_decrypt_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if ((iv_len == 0) || !GcmTagLenValid(tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  GcmCrypt(ctx, iv, iv_len, aad, aad_len, buf, length, 0, full);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+void AES_GMAC_init(struct AES_GMAC_ctx* ctx, const struct AES_GCM_ctx* key, const uint8_t* iv, size_t iv_len)
+{
+  // An empty IV is not allowed: the context is left without a key, so it gives no tag and verifies nothing
+  ctx->key = NULL;
+  ctx->length = 0;
+  if (iv_len == 0)
+  {
+    return;
+  }
+  ctx->key = key;
+  GcmCounter0(key, iv, iv_len, ctx->mask);
+  Cipher((state_t*)ctx->mask, key->aes.RoundKey);
+  ctx->X[0] = 0;
+  ctx->X[1] = 0;
+}
+
+void AES_GMAC_update(struct AES_GMAC_ctx* ctx, const uint8_t* data, size_t length)
+{
+  size_t pos = (size_t)(ctx->length % AES_BLOCKLEN);
+  size_t n;
+
+  if (!ctx->key)
+  {
+    return;
+  }
+  ctx->length += length;
+  if (pos != 0)
+  {
+    n = (length < AES_BLOCKLEN - pos) ? length : AES_BLOCKLEN - pos;
+    memcpy(ctx->block + pos, data, n);
+    if (pos + n < AES_BLOCKLEN)
+    {
+      return;
+    }
+    GhashBlocks(&ctx->key->H, ctx->X, ctx->block, 1);
+    data += n;
+    length -= n;
+  }
+  GhashBlocks(&ctx->key->H, ctx->X, data, length / AES_BLOCKLEN);
+  memcpy(ctx->block, data + length / AES_BLOCKLEN * AES_BLOCKLEN, length % AES_BLOCKLEN);
+}
+
+void AES_GMAC_final(struct AES_GMAC_ctx* ctx, uint8_t* tag, size_t tag_len)
+{
+  size_t pos = (size_t)(ctx->length % AES_BLOCKLEN);
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!ctx->key || !GcmTagLenValid(tag_len))
+  {
+    return;
+  }
+  if (pos != 0)
+  {
+    memset(ctx->block + pos, 0, AES_BLOCKLEN - pos);
+    GhashBlocks(&ctx->key->H, ctx->X, ctx->block, 1);
+  }
+  PutBE64(ctx->block, ctx->length * 8);
+  PutBE64(ctx->block + 8, 0);
+  GhashBlocks(&ctx->key->H, ctx->X, ctx->block, 1);
+
+  PutBE64(full, ctx->X[0]);
+  PutBE64(full + 8, ctx->X[1]);
+  XorBlock(full, ctx->mask);
+  memcpy(tag, full, tag_len);
+}
+
+int AES_GMAC_verify(struct AES_GMAC_ctx* ctx, const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!ctx->key || !GcmTagLenValid(tag_len))
+  {
+    return 1;
+  }
+  AES_GMAC_final(ctx, full, AES_BLOCKLEN);
+  return TagsDiffer(full, tag, tag_len) != 0;
+}
+
+void AES_GMAC_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* tag, size_t tag_len)
+{
+  struct AES_GMAC_ctx gmac;
+
+  AES_GMAC_init(&gmac, ctx, iv, iv_len);
+  AES_GMAC_update(&gmac, aad, aad_len);
+  AES_GMAC_final(&gmac, tag, tag_len);
+}
+
+#endif // #if defined(GCM) && (GCM == 1)
+
+
+
+#if defined(CCM) && (CCM == 1)
+
+// Absorbs data into the CBC-MAC state Y, *pos being the number of bytes already XOR'ed into Y
+static void CcmMacUpdate(const roundKey_t* RoundKey, uint8_t* Y, uint8_t* pos, const uint8_t* data, size_t length)
+{
+  for (; length > 0; --length)
+  {
+    Y[(*pos)++] ^= *data++;
+    if (*pos == AES_BLOCKLEN)
+    {
+      Cipher((state_t*)Y, RoundKey);
+      *pos = 0;
+    }
+  }
+}
+
+// Sets up B0 and A0, then MACs B0 and computes S0 = E(A0) in one two-block call and MACs the associated data.
+// On return A holds the counter block A1 for the first payload block.
+static void CcmStart(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                     const uint8_t* aad, size_t aad_len, size_t length, size_t tag_len,
+                     uint8_t* Y, uint8_t* A, uint8_t* S0)
+{
+  uint8_t L = (uint8_t)(15 - nonce_len);
+  uint8_t enc[10];
+  uint8_t i, n, pos = 0, enc_len;
+  uint8_t* B0;
+  uint64_t v;
+  state_t s[2];
+
+  B0 = (uint8_t*)&s[0];
+  B0[0] = (uint8_t)(((aad_len > 0) ? 0x40 : 0) | ((tag_len > 0) ? ((tag_len - 2) / 2) << 3 : 0) | (L - 1));
+  memcpy(B0 + 1, nonce, nonce_len);
+  for (i = 0, v = length; i < L; ++i, v >>= 8)
+  {
+    B0[AES_BLOCKLEN - 1 - i] = (uint8_t)v;
+  }
+
+  memset(A, 0, AES_BLOCKLEN);
+  A[0] = (uint8_t)(L - 1);
+  memcpy(A + 1, nonce, nonce_len);
+  memcpy(&s[1], A, AES_BLOCKLEN);
+
+  CipherBlocks(s, 2, ctx->RoundKey);
+  memcpy(Y, &s[0], AES_BLOCKLEN);
+  memcpy(S0, &s[1], AES_BLOCKLEN);
+  IncrementCounter(A, L);
+
+  if (aad_len > 0)
+  {
+    // the length of the associated data is encoded in 2, 0xFFFE + 4 or 0xFFFF + 8 bytes
+    v = aad_len;
+    if (v < 0xFF00)
+    {
+      enc_len = n = 2;
+    }
+    else
+    {
+      enc[0] = 0xFF;
+      enc[1] = ((v >> 32) == 0) ? 0xFE : 0xFF;
+      n = (enc[1] == 0xFE) ? 4 : 8;
+      enc_len = n + 2;
+    }
+    for (i = 0; i < n; ++i, v >>= 8)
+    {
+      enc[enc_len - 1 - i] = (uint8_t)v;
+    }
+    CcmMacUpdate(ctx->RoundKey, Y, &pos, enc, enc_len);
+    CcmMacUpdate(ctx->RoundKey, Y, &pos, aad, aad_len);
+    if (pos != 0)
+    {
+      Cipher((state_t*)Y, ctx->RoundKey);
+    }
+  }
+}
+
+// Encrypts or decrypts buf and computes the full 16 byte tag in a single pass.
+// Every CipherBlocks() call runs one CBC-MAC block and one CTR keystream block side by side.
+// When decrypting, the plaintext of a block is only known after its keystream is applied,
+// so the MAC of each block is paired with the keystream of the next one.
+static void CcmCrypt(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                     size_t tag_len, uint8_t encrypt, uint8_t* tag)
+{
+  uint8_t L = (uint8_t)(15 - nonce_len);
+  uint8_t Y[AES_BLOCKLEN], A[AES_BLOCKLEN], S0[AES_BLOCKLEN];
+  uint8_t* ks;
+  uint8_t* pending = 0;
+  size_t i, n, pending_len = 0;
+  state_t s[2];
+
+  CcmStart(ctx, nonce, nonce_len, aad, aad_len, length, tag_len, Y, A, S0);
+
+  for (; length > 0; length -= n, buf += n)
+  {
+    n = (length < AES_BLOCKLEN) ? length : AES_BLOCKLEN;
+    if (encrypt)
+    {
+      pending = buf;
+      pending_len = n;
+    }
+
+    memcpy(&s[0], Y, AES_BLOCKLEN);
+    for (i = 0; i < pending_len; ++i)
+    {
+      ((uint8_t*)&s[0])[i] ^= pending[i];
+    }
+    memcpy(&s[1], A, AES_BLOCKLEN);
+    IncrementCounter(A, L);
+
+    if (pending != 0)
+    {
+      CipherBlocks(s, 2, ctx->RoundKey);
+      memcpy(Y, &s[0], AES_BLOCKLEN);
+    }
+    else
+    {
+      Cipher(&s[1], ctx->RoundKey);
+    }
+
+    ks = (uint8_t*)&s[1];
+    for (i = 0; i < n; ++i)
+    {
+      buf[i] ^= ks[i];
+    }
+    pending = buf;
+    pending_len = n;
+  }
+
+  // the last plaintext block is still to be MAC'ed when decrypting
+  if (!encrypt && (pending != 0))
+  {
+    for (i = 0; i < pending_len; ++i)
+    {
+      Y[i] ^= pending[i];
+    }
+    Cipher((state_t*)Y, ctx->RoundKey);
+  }
+
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    tag[i] = Y[i] ^ S0[i];
+  }
+}
+
+// SP 800-38C: nonces are 7 to 13 bytes, tags 4 to 16 bytes and even (or 0 for CCM*), and the message length
+// must fit in the L = 15 - nonce_len bytes left for it, so that the counter never wraps into A0
+static uint8_t CcmLengthsValid(size_t nonce_len, size_t tag_len, size_t length)
+{
+  size_t L = 15 - nonce_len;
+
+  if ((nonce_len < 7) || (nonce_len > 13) || (tag_len > AES_BLOCKLEN) || (tag_len % 2 != 0) || (tag_len == 2))
+  {
+    return 0;
+  }
+  return (L >= sizeof(size_t)) || ((length >> (8 * L)) == 0);
+}
+
+void AES_CCM_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!CcmLengthsValid(nonce_len, tag_len, length))
+  {
+    return;
+  }
+  CcmCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, tag_len, 1, full);
+  memcpy(tag, full, tag_len);
+}
+
+int AES_CCM_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!CcmLengthsValid(nonce_len, tag_len, length))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  CcmCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, tag_len, 0, full);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+#endif // #if defined(CCM) && (CCM == 1)
+
+
+
+#if defined(OCB) && (OCB == 1)
+
+void AES_OCB_init_ctx(struct AES_OCB_ctx* ctx, const uint8_t* key)
+{
+  uint8_t i;
+
+  AES_init_ctx(&ctx->aes, key);
+  memset(ctx->Lstar, 0, AES_BLOCKLEN);
+  Cipher((state_t*)ctx->Lstar, ctx->aes.RoundKey);
+  DoubleBlock(ctx->Ldollar, ctx->Lstar);
+  DoubleBlock(ctx->L[0], ctx->Ldollar);
+  for (i = 1; i < OCB_L_COUNT; ++i)
+  {
+    DoubleBlock(ctx->L[i], ctx->L[i - 1]);
+  }
+}
+
+// Updates Offset for block number i (counting from 1): Offset ^= L_ntz(i)
+static void OcbNextOffset(const struct AES_OCB_ctx* ctx, uint8_t* Offset, size_t i)
+{
+  uint8_t L[AES_BLOCKLEN];
+  size_t ntz = 0;
+
+  for (; (i & 1) == 0; i >>= 1)
+  {
+    ++ntz;
+  }
+  if (ntz < OCB_L_COUNT)
+  {
+    XorBlock(Offset, ctx->L[ntz]);
+    return;
+  }
+  DoubleBlock(L, ctx->L[OCB_L_COUNT - 1]);
+  for (; ntz > OCB_L_COUNT; --ntz)
+  {
+    DoubleBlock(L, L);
+  }
+  XorBlock(Offset, L);
+}
+
+// Runs all full blocks of a message through out_i = Offset_i ^ E(in_i ^ Offset_i), or the inverse cipher
+// when decrypting. The blocks are independent, so AES_LANES of them go through the cipher together.
+// Without out, the cipher outputs are summed up in Sum instead (the HASH of the aad).
+static void OcbBlocks(const struct AES_OCB_ctx* ctx, uint8_t* Offset, const uint8_t* in, uint8_t* out,
+                      size_t nblocks, uint8_t encrypt, uint8_t* Sum)
+{
+  state_t s[AES_LANES];
+  uint8_t offsets[AES_LANES][AES_BLOCKLEN];
+  size_t i = 0, j, n;
+
+  for (; nblocks > 0; nblocks -= n, in += n * AES_BLOCKLEN)
+  {
+    n = (nblocks < AES_LANES) ? nblocks : AES_LANES;
+    for (j = 0; j < n; ++j)
+    {
+      OcbNextOffset(ctx, Offset, ++i);
+      memcpy(offsets[j], Offset, AES_BLOCKLEN);
+      memcpy(&s[j], in + j * AES_BLOCKLEN, AES_BLOCKLEN);
+      XorBlock((uint8_t*)&s[j], Offset);
+    }
+
+    if (encrypt)
+    {
+      CipherBlocks(s, n, ctx->aes.RoundKey);
+    }
+    else
+    {
+      InvCipherBlocks(s, n, ctx->aes.RoundKey);
+    }
+
+    for (j = 0; j < n; ++j)
+    {
+      if (out == 0)
+      {
+        XorBlock(Sum, (uint8_t*)&s[j]);
+      }
+      else
+      {
+        XorBlock((uint8_t*)&s[j], offsets[j]);
+        memcpy(out, &s[j], AES_BLOCKLEN);
+        out += AES_BLOCKLEN;
+      }
+    }
+  }
+}
+
+// HASH(K, A) of RFC 7253
+static void OcbHash(const struct AES_OCB_ctx* ctx, const uint8_t* aad, size_t aad_len, uint8_t* Sum)
+{
+  uint8_t Offset[AES_BLOCKLEN] = { 0 };
+  uint8_t block[AES_BLOCKLEN];
+  size_t full = aad_len / AES_BLOCKLEN;
+  size_t rem = aad_len % AES_BLOCKLEN;
+
+  memset(Sum, 0, AES_BLOCKLEN);
+  OcbBlocks(ctx, Offset, aad, 0, full, 1, Sum);
+  if (rem != 0)
+  {
+    XorBlock(Offset, ctx->Lstar);
+    memset(block, 0, AES_BLOCKLEN);
+    memcpy(block, aad + full * AES_BLOCKLEN, rem);
+    block[rem] = 0x80;
+    XorBlock(block, Offset);
+    Cipher((state_t*)block, ctx->aes.RoundKey);
+    XorBlock(Sum, block);
+  }
+}
+
+// Offset_0 from the nonce and tag length
+static void OcbInitialOffset(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                             size_t tag_len, uint8_t* Offset)
+{
+  uint8_t Stretch[AES_BLOCKLEN + 8];
+  uint8_t bottom, shift, i;
+
+  memset(Stretch, 0, AES_BLOCKLEN);
+  Stretch[0] = (uint8_t)(((tag_len * 8) % 128) << 1);
+  Stretch[AES_BLOCKLEN - 1 - nonce_len] |= 1;
+  memcpy(Stretch + AES_BLOCKLEN - nonce_len, nonce, nonce_len);
+  bottom = Stretch[AES_BLOCKLEN - 1] & 0x3F;
+  Stretch[AES_BLOCKLEN - 1] &= 0xC0;
+
+  // Stretch = Ktop || (Ktop[1..64] xor Ktop[9..72])
+  Cipher((state_t*)Stretch, ctx->aes.RoundKey);
+  for (i = 0; i < 8; ++i)
+  {
+    Stretch[AES_BLOCKLEN + i] = Stretch[i] ^ Stretch[i + 1];
+  }
+
+  // Offset_0 = Stretch[1+bottom..128+bottom]
+  shift = bottom % 8;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    Offset[i] = (uint8_t)(Stretch[i + bottom / 8] << shift);
+    if (shift != 0)
+    {
+      Offset[i] |= (uint8_t)(Stretch[i + bottom / 8 + 1] >> (8 - shift));
+    }
+  }
+}
+
+static void OcbCrypt(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                     size_t tag_len, uint8_t encrypt, uint8_t* tag)
+{
+  uint8_t Offset[AES_BLOCKLEN], Checksum[AES_BLOCKLEN] = { 0 }, Pad[AES_BLOCKLEN];
+  size_t i, full = length / AES_BLOCKLEN;
+  size_t rem = length % AES_BLOCKLEN;
+
+  OcbInitialOffset(ctx, nonce, nonce_len, tag_len, Offset);
+
+  if (encrypt)
+  {
+    for (i = 0; i < full * AES_BLOCKLEN; i += AES_BLOCKLEN)
+    {
+      XorBlock(Checksum, buf + i);
+    }
+  }
+  OcbBlocks(ctx, Offset, buf, buf, full, encrypt, 0);
+  if (!encrypt)
+  {
+    for (i = 0; i < full * AES_BLOCKLEN; i += AES_BLOCKLEN)
+    {
+      XorBlock(Checksum, buf + i);
+    }
+  }
+  buf += full * AES_BLOCKLEN;
+
+  if (rem != 0)
+  {
+    XorBlock(Offset, ctx->Lstar);
+    memcpy(Pad, Offset, AES_BLOCKLEN);
+    Cipher((state_t*)Pad, ctx->aes.RoundKey);
+    for (i = 0; i < rem; ++i)
+    {
+      if (encrypt)
+      {
+        Checksum[i] ^= buf[i];
+      }
+      buf[i] ^= Pad[i];
+      if (!encrypt)
+      {
+        Checksum[i] ^= buf[i];
+      }
+    }
+    Checksum[rem] ^= 0x80;
+  }
+
+  // Tag = E(Checksum ^ Offset ^ L_$) ^ HASH(K, A)
+  XorBlock(Checksum, Offset);
+  XorBlock(Checksum, ctx->Ldollar);
+  Cipher((state_t*)Checksum, ctx->aes.RoundKey);
+  OcbHash(ctx, aad, aad_len, tag);
+  XorBlock(tag, Checksum);
+}
+
+// RFC 7253: nonces are 1 to 15 bytes and tags 1 to 16 bytes
+static uint8_t OcbLengthsValid(size_t nonce_len, size_t tag_len)
+{
+  return (nonce_len >= 1) && (nonce_len < AES_BLOCKLEN) && (tag_len >= 1) && (tag_len <= AES_BLOCKLEN);
+}
+
+void AES_OCB_encrypt_buffer(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!OcbLengthsValid(nonce_len, tag_len))
+  {
+    return;
+  }
+  OcbCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, tag_len, 1, full);
+  memcpy(tag, full, tag_len);
+}
+
+int AES_OCB_decrypt_buffer(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if (!OcbLengthsValid(nonce_len, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  OcbCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, tag_len, 0, full);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+#endif // #if defined(OCB) && (OCB == 1)
+
+
+
+#if defined(XTS) && (XTS == 1)
+
+void AES_XTS_init_ctx(struct AES_XTS_ctx* ctx, const uint8_t* key)
+{
+  AES_init_ctx(&ctx->data, key);
+  AES_init_ctx(&ctx->tweak, key + AES_KEYLEN);
+}
+
+// The tweak is a little-endian 128 bit number, kept as two 64 bit words { low, high }
+// so that multiplying it by alpha is a handful of word operations instead of a loop over 16 bytes.
+static void XtsDouble(uint64_t T[2])
+{
+  uint64_t carry = (uint64_t)0 - (T[1] >> 63);
+  T[1] = (T[1] << 1) | (T[0] >> 63);
+  T[0] = (T[0] << 1) ^ (carry & 0x87);
+}
+
+static void XorTweak(uint8_t* buf, const uint64_t T[2])
+{
+  uint8_t i;
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    buf[i] ^= (uint8_t)(T[i / 8] >> (8 * (i % 8)));
+  }
+}
+
+// Processes nblocks full blocks with the tweaks T, T*alpha, T*alpha^2, ..., AES_LANES blocks per cipher call.
+// T is left at the tweak of the next block.
+static void XtsBlocks(const struct AES_XTS_ctx* ctx, uint64_t T[2], uint8_t* buf, size_t nblocks, uint8_t encrypt)
+{
+  state_t s[AES_LANES];
+  uint64_t tweaks[AES_LANES][2];
+  size_t j, n;
+
+  for (; nblocks > 0; nblocks -= n, buf += n * AES_BLOCKLEN)
+  {
+    n = (nblocks < AES_LANES) ? nblocks : AES_LANES;
+    for (j = 0; j < n; ++j)
+    {
+      tweaks[j][0] = T[0];
+      tweaks[j][1] = T[1];
+      XtsDouble(T);
+      memcpy(&s[j], buf + j * AES_BLOCKLEN, AES_BLOCKLEN);
+      XorTweak((uint8_t*)&s[j], tweaks[j]);
+    }
+
+    if (encrypt)
+    {
+      CipherBlocks(s, n, ctx->data.RoundKey);
+    }
+    else
+    {
+      InvCipherBlocks(s, n, ctx->data.RoundKey);
+    }
+
+    for (j = 0; j < n; ++j)
+    {
+      XorTweak((uint8_t*)&s[j], tweaks[j]);
+      memcpy(buf + j * AES_BLOCKLEN, &s[j], AES_BLOCKLEN);
+    }
+  }
+}
+
+// Processes one data unit whose encrypted sector number is T0.
+// A trailing partial block steals the tail of the last full block's ciphertext. When decrypting,
+// the two final blocks are processed with their tweaks swapped.
+static void XtsUnit(const struct AES_XTS_ctx* ctx, const uint8_t* T0, uint8_t* buf, size_t length, uint8_t encrypt)
+{
+  uint64_t T[2], Tm[2];
+  size_t full = length / AES_BLOCKLEN;
+  size_t rem = length % AES_BLOCKLEN;
+  uint8_t i, tmp;
+
+  T[0] = 0;
+  T[1] = 0;
+  for (i = AES_BLOCKLEN; i > 0; --i)
+  {
+    T[(i - 1) / 8] = (T[(i - 1) / 8] << 8) | T0[i - 1];
+  }
+
+  if (rem == 0)
+  {
+    XtsBlocks(ctx, T, buf, full, encrypt);
+    return;
+  }
+
+  XtsBlocks(ctx, T, buf, full - 1, encrypt);
+  buf += (full - 1) * AES_BLOCKLEN;
+  Tm[0] = T[0];
+  Tm[1] = T[1];
+  XtsDouble(Tm);
+
+  XtsBlocks(ctx, encrypt ? T : Tm, buf, 1, encrypt);
+  for (i = 0; i < rem; ++i)
+  {
+    tmp = buf[AES_BLOCKLEN + i];
+    buf[AES_BLOCKLEN + i] = buf[i];
+    buf[i] = tmp;
+  }
+  XtsBlocks(ctx, encrypt ? Tm : T, buf, 1, encrypt);
+}
+
+// Encrypts the sector numbers of AES_LANES data units at a time, then processes the units.
+static void XtsSectors(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf,
+                       size_t sector_size, size_t nsectors, uint8_t encrypt)
+{
+  state_t tweaks[AES_LANES];
+  uint64_t v;
+  size_t j, n;
+  uint8_t i;
+
+  if (sector_size < AES_BLOCKLEN)
+  {
+    return;
+  }
+  for (; nsectors > 0; nsectors -= n)
+  {
+    n = (nsectors < AES_LANES) ? nsectors : AES_LANES;
+    memset(tweaks, 0, sizeof(tweaks));
+    for (j = 0; j < n; ++j)
+    {
+      for (i = 0, v = sector + j; i < 8; ++i, v >>= 8)
+      {
+        ((uint8_t*)&tweaks[j])[i] = (uint8_t)v;
+      }
+    }
+    CipherBlocks(tweaks, n, ctx->tweak.RoundKey);
+
+    for (j = 0; j < n; ++j, buf += sector_size)
+    {
+      XtsUnit(ctx, (const uint8_t*)&tweaks[j], buf, sector_size, encrypt);
+    }
+    sector += n;
+  }
+}
+
+void AES_XTS_encrypt_buffer(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf, size_t length)
+{
+  XtsSectors(ctx, sector, buf, length, 1, 1);
+}
+
+void AES_XTS_decrypt_buffer(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf, size_t length)
+{
+  XtsSectors(ctx, sector, buf, length, 1, 0);
+}
+
+void AES_XTS_encrypt_sectors(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf,
+                             size_t sector_size, size_t nsectors)
+{
+  XtsSectors(ctx, sector, buf, sector_size, nsectors, 1);
+}
+
+void AES_XTS_decrypt_sectors(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf,
+                             size_t sector_size, size_t nsectors)
+{
+  XtsSectors(ctx, sector, buf, sector_size, nsectors, 0);
+}
+
+#endif // #if defined(XTS) && (XTS == 1)
+
+
+
+#if defined(CFB) && (CFB == 1)
+
+// Encryption is sequential: the input to the cipher is the previous ciphertext block.
+void AES_CFB_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  size_t i;
+  uint8_t bi, n;
+  for (i = 0; i < length; i += AES_BLOCKLEN, buf += AES_BLOCKLEN)
+  {
+    n = (length - i < AES_BLOCKLEN) ? (uint8_t)(length - i) : AES_BLOCKLEN;
+    Cipher((state_t*)ctx->Iv, ctx->RoundKey);
+    for (bi = 0; bi < n; ++bi)
+    {
+      buf[bi] ^= ctx->Iv[bi];
+      ctx->Iv[bi] = buf[bi];
+    }
+  }
+}
+
+// Decryption is parallel: the inputs are the Iv and the ciphertext, so AES_LANES blocks are encrypted at once.
+void AES_CFB_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  state_t s[AES_LANES];
+  size_t j, n, bytes;
+
+  for (; length > 0; length -= bytes, buf += bytes)
+  {
+    bytes = (length < sizeof(s)) ? length : sizeof(s);
+    n = (bytes + AES_BLOCKLEN - 1) / AES_BLOCKLEN;
+    memcpy(&s[0], ctx->Iv, AES_BLOCKLEN);
+    memcpy(&s[1], buf, (n - 1) * AES_BLOCKLEN);
+    memcpy(ctx->Iv, buf + (n - 1) * AES_BLOCKLEN, bytes - (n - 1) * AES_BLOCKLEN);
+    CipherBlocks(s, n, ctx->RoundKey);
+    for (j = 0; j < bytes; ++j)
+    {
+      buf[j] ^= ((uint8_t*)s)[j];
+    }
+  }
+}
+
+// Shifts the Iv left by n <= AES_BLOCKLEN bytes, filling it up with the ciphertext bytes c
+static void Cfb8Shift(uint8_t* Iv, const uint8_t* c, size_t n)
+{
+  uint8_t bi;
+  for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+  {
+    Iv[bi] = (bi + n < AES_BLOCKLEN) ? Iv[bi + n] : c[bi + n - AES_BLOCKLEN];
+  }
+}
+
+void AES_CFB8_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  state_t s;
+  size_t i;
+  for (i = 0; i < length; ++i)
+  {
+    memcpy(&s, ctx->Iv, AES_BLOCKLEN);
+    Cipher(&s, ctx->RoundKey);
+    buf[i] ^= s.a[0][0];
+    Cfb8Shift(ctx->Iv, &buf[i], 1);
+  }
+}
+
+// The input to the cipher for every byte is the preceding AES_BLOCKLEN bytes of Iv || ciphertext,
+// so up to AES_LANES bytes are decrypted per call of CipherBlocks().
+void AES_CFB8_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  state_t s[AES_LANES];
+  size_t j, n;
+  uint8_t bi;
+
+  for (; length > 0; length -= n, buf += n)
+  {
+    n = (length < AES_LANES) ? length : AES_LANES;
+    n = (n < AES_BLOCKLEN) ? n : AES_BLOCKLEN;
+    for (j = 0; j < n; ++j)
+    {
+      for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+      {
+        ((uint8_t*)&s[j])[bi] = (bi + j < AES_BLOCKLEN) ? ctx->Iv[bi + j] : buf[bi + j - AES_BLOCKLEN];
+      }
+    }
+    Cfb8Shift(ctx->Iv, buf, n);
+    CipherBlocks(s, n, ctx->RoundKey);
+    for (j = 0; j < n; ++j)
+    {
+      buf[j] ^= s[j].a[0][0];
+    }
+  }
+}
+
+#endif // #if defined(CFB) && (CFB == 1)
+
+
+
+#if defined(OFB) && (OFB == 1)
+
+// Every keystream block is the encryption of the one before, so the blocks cannot be interleaved.
+// Instead the keystream for AES_LANES blocks is generated ahead and the buffer is XOR'ed in one pass.
+void AES_OFB_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length)
+{
+  uint8_t keystream[AES_LANES * AES_BLOCKLEN];
+  size_t i, bytes;
+
+  for (; length > 0; length -= bytes, buf += bytes)
+  {
+    bytes = (length < sizeof(keystream)) ? length : sizeof(keystream);
+    for (i = 0; i < bytes; i += AES_BLOCKLEN)
+    {
+      Cipher((state_t*)ctx->Iv, ctx->RoundKey);
+      memcpy(keystream + i, ctx->Iv, AES_BLOCKLEN);
+    }
+    for (i = 0; i < bytes; ++i)
+    {
+      buf[i] ^= keystream[i];
+    }
+  }
+}
+
+#endif // #if defined(OFB) && (OFB == 1)
+
+
+
+#if OMAC
+
+static void CmacInit(struct AES_CMAC_ctx* ctx, const uint8_t* key)
+{
+  uint8_t L[AES_BLOCKLEN];
+
+  AES_init_ctx(&ctx->aes, key);
+  memset(L, 0, AES_BLOCKLEN);
+  Cipher((state_t*)L, ctx->aes.RoundKey);
+  DoubleBlock(ctx->K1, L);
+  DoubleBlock(ctx->K2, ctx->K1);
+}
+
+// XORs the last block of a message, left <= AES_BLOCKLEN bytes, into X with K1, or padded with K2
+static void CmacLastBlock(const struct AES_CMAC_ctx* ctx, uint8_t* X, const uint8_t* last, size_t left)
+{
+  size_t i;
+
+  if (left == AES_BLOCKLEN)
+  {
+    XorBlock(X, last);
+    XorBlock(X, ctx->K1);
+  }
+  else
+  {
+    for (i = 0; i < left; ++i)
+    {
+      X[i] ^= last[i];
+    }
+    X[left] ^= 0x80;
+    XorBlock(X, ctx->K2);
+  }
+}
+
+// XORs the next block of msg into the chaining value X, *pos being the number of bytes already absorbed.
+// The last block is XOR'ed with K1, or padded and XOR'ed with K2. Returns 1 when that last block was absorbed.
+static uint8_t CmacAbsorb(const struct AES_CMAC_ctx* ctx, uint8_t* X, const uint8_t* msg, size_t length, size_t* pos)
+{
+  size_t left = length - *pos;
+
+  if (left > AES_BLOCKLEN)
+  {
+    XorBlock(X, msg + *pos);
+    *pos += AES_BLOCKLEN;
+    return 0;
+  }
+
+  CmacLastBlock(ctx, X, msg + *pos, left);
+  *pos = length;
+  return 1;
+}
+
+// Every lane of CipherBlocks() holds the chain of one message. A lane whose message is done is
+// handed the next message right away, so short and long messages can be mixed without idle lanes.
+// The chain of message i starts at start + i * AES_BLOCKLEN, or at zero if start is 0.
+static void CmacMessages(const struct AES_CMAC_ctx* ctx, const uint8_t* const* msgs, const size_t* lengths,
+                         const uint8_t* start, size_t count, uint8_t* macs)
+{
+  state_t X[AES_LANES];
+  size_t msg[AES_LANES];
+  size_t pos[AES_LANES];
+  uint8_t last[AES_LANES];
+  size_t next = 0, j, n = 0;
+
+  for (;;)
+  {
+    for (; (n < AES_LANES) && (next < count); ++n, ++next)
+    {
+      if (start)
+      {
+        memcpy(&X[n], start + next * AES_BLOCKLEN, AES_BLOCKLEN);
+      }
+      else
+      {
+        memset(&X[n], 0, AES_BLOCKLEN);
+      }
+      msg[n] = next;
+      pos[n] = 0;
+    }
+    if (n == 0)
+    {
+      break;
+    }
+
+    for (j = 0; j < n; ++j)
+    {
+      last[j] = CmacAbsorb(ctx, (uint8_t*)&X[j], msgs[msg[j]], lengths[msg[j]], &pos[j]);
+    }
+    CipherBlocks(X, n, ctx->aes.RoundKey);
+
+    // Retire the finished chains, moving the last lane into the freed one
+    for (j = 0; j < n; )
+    {
+      if (last[j])
+      {
+        memcpy(macs + msg[j] * AES_BLOCKLEN, &X[j], AES_BLOCKLEN);
+        --n;
+        X[j] = X[n];
+        msg[j] = msg[n];
+        pos[j] = pos[n];
+        last[j] = last[n];
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
+
+#endif // #if OMAC
+
+
+
+#if defined(CMAC) && (CMAC == 1)
+
+void AES_CMAC_init_ctx(struct AES_CMAC_ctx* ctx, const uint8_t* key)
+{
+  CmacInit(ctx, key);
+}
+
+void AES_CMAC_buffer(const struct AES_CMAC_ctx* ctx, const uint8_t* msg, size_t length, uint8_t* mac)
+{
+  CmacMessages(ctx, &msg, &length, 0, 1, mac);
+}
+
+void AES_CMAC_buffers(const struct AES_CMAC_ctx* ctx, const uint8_t* const* msgs, const size_t* lengths,
+                      size_t count, uint8_t* macs)
+{
+  CmacMessages(ctx, msgs, lengths, 0, count, macs);
+}
+
+// Copies n bytes from offset pos of the KDF input [i]_32 || label || 0x00 || context || [L]_32, hd holding
+// the counter and tl the output length.
+static void KdfGather(uint8_t* block, size_t pos, size_t n, const uint8_t* hd, const uint8_t* label, size_t label_len,
+                      const uint8_t* context, size_t context_len, const uint8_t* tl)
+{
+  static const uint8_t zero = 0;
+  const uint8_t* seg[5];
+  size_t len[5];
+  size_t s, k;
+
+  seg[0] = hd;      len[0] = 4;
+  seg[1] = label;   len[1] = label_len;
+  seg[2] = &zero;   len[2] = 1;
+  seg[3] = context; len[3] = context_len;
+  seg[4] = tl;      len[4] = 4;
+
+  for (s = 0; (s < 5) && (n > 0); ++s)
+  {
+    if (pos >= len[s])
+    {
+      pos -= len[s];
+      continue;
+    }
+    k = (len[s] - pos < n) ? len[s] - pos : n;
+    memcpy(block, seg[s] + pos, k);
+    block += k;
+    n -= k;
+    pos = 0;
+  }
+}
+
+// Runs the CMAC chains of the count * nblocks KDF blocks side by side, like CmacMessages(). Job j computes
+// block j % nblocks of output j / nblocks, so all blocks of one output and of the next ones share the lanes.
+static void KdfMessages(const struct AES_CMAC_ctx* ctx, const uint8_t* const* labels, const size_t* label_lens,
+                        const uint8_t* const* contexts, const size_t* context_lens, size_t count, uint8_t* out, size_t out_len)
+{
+  state_t X[AES_LANES];
+  uint8_t hd[AES_LANES][4];
+  uint8_t tl[4];
+  uint8_t block[AES_BLOCKLEN];
+  size_t job[AES_LANES];
+  size_t pos[AES_LANES];
+  uint8_t last[AES_LANES];
+  size_t nblocks = (out_len + AES_BLOCKLEN - 1) / AES_BLOCKLEN;
+  size_t njobs = count * nblocks;
+  size_t next = 0, j, n = 0, o, b, length, left;
+
+  tl[0] = (uint8_t)(out_len >> 21);
+  tl[1] = (uint8_t)(out_len >> 13);
+  tl[2] = (uint8_t)(out_len >> 5);
+  tl[3] = (uint8_t)(out_len << 3);
+
+  for (;;)
+  {
+    for (; (n < AES_LANES) && (next < njobs); ++n, ++next)
+    {
+      b = next % nblocks + 1;
+      hd[n][0] = (uint8_t)(b >> 24);
+      hd[n][1] = (uint8_t)(b >> 16);
+      hd[n][2] = (uint8_t)(b >> 8);
+      hd[n][3] = (uint8_t)b;
+      memset(&X[n], 0, AES_BLOCKLEN);
+      job[n] = next;
+      pos[n] = 0;
+    }
+    if (n == 0)
+    {
+      break;
+    }
+
+    for (j = 0; j < n; ++j)
+    {
+      o = job[j] / nblocks;
+      length = 9 + label_lens[o] + context_lens[o];
+      left = length - pos[j];
+      KdfGather(block, pos[j], (left < AES_BLOCKLEN) ? left : AES_BLOCKLEN,
+                hd[j], labels[o], label_lens[o], contexts[o], context_lens[o], tl);
+      last[j] = (left <= AES_BLOCKLEN);
+      if (last[j])
+      {
+        CmacLastBlock(ctx, (uint8_t*)&X[j], block, left);
+      }
+      else
+      {
+        XorBlock((uint8_t*)&X[j], block);
+        pos[j] += AES_BLOCKLEN;
+      }
+    }
+    CipherBlocks(X, n, ctx->aes.RoundKey);
+
+    // Retire the finished chains, the last block of an output being truncated to out_len
+    for (j = 0; j < n; )
+    {
+      if (last[j])
+      {
+        o = job[j] / nblocks;
+        b = (job[j] % nblocks) * AES_BLOCKLEN;
+        memcpy(out + o * out_len + b, &X[j], (out_len - b < AES_BLOCKLEN) ? out_len - b : AES_BLOCKLEN);
+        --n;
+        X[j] = X[n];
+        memmove(hd[j], hd[n], 4); // j == n when the last chain retires itself
+        job[j] = job[n];
+        pos[j] = pos[n];
+        last[j] = last[n];
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
+
+void AES_CMAC_KDF_buffer(const struct AES_CMAC_ctx* ctx, const uint8_t* label, size_t label_len,
+                         const uint8_t* context, size_t context_len, uint8_t* out, size_t out_len)
+{
+  KdfMessages(ctx, &label, &label_len, &context, &context_len, 1, out, out_len);
+}
+
+void AES_CMAC_KDF_buffers(const struct AES_CMAC_ctx* ctx, const uint8_t* const* labels, const size_t* label_lens,
+                          const uint8_t* const* contexts, const size_t* context_lens, size_t count,
+                          uint8_t* out, size_t out_len)
+{
+  KdfMessages(ctx, labels, label_lens, contexts, context_lens, count, out, out_len);
+}
+
+#endif // #if defined(CMAC) && (CMAC == 1)
+
+
+
+#if defined(GCM_SIV) && (GCM_SIV == 1)
+
+// Derives the message authentication key and message encryption key for nonce. All the derivation blocks
+// are independent, so they go through the cipher in a single CipherBlocks() call.
+static void GcmSivKeys(const struct AES_ctx* ctx, const uint8_t* nonce, ghashKey_t* H, struct AES_ctx* enc)
+{
+  state_t blocks[2 + AES_KEYLEN / 8];
+  uint8_t key[16 + AES_KEYLEN];
+  uint8_t j;
+
+  for (j = 0; j < 2 + AES_KEYLEN / 8; ++j)
+  {
+    memset(&blocks[j], 0, 4);
+    ((uint8_t*)&blocks[j])[0] = j;
+    memcpy((uint8_t*)&blocks[j] + 4, nonce, 12);
+  }
+  CipherBlocks(blocks, 2 + AES_KEYLEN / 8, ctx->RoundKey);
+  for (j = 0; j < 2 + AES_KEYLEN / 8; ++j)
+  {
+    memcpy(key + 8 * j, &blocks[j], 8);
+  }
+
+  PolyvalInit(H, key);
+  KeyExpansion(enc->RoundKey, key + 16);
+  memset(key, 0, sizeof(key));
+}
+
+// Computes the tag from the POLYVAL state of aad and plaintext
+static void GcmSivTag(const struct AES_ctx* enc, const ghashKey_t* H, uint64_t X[2], const uint8_t* nonce,
+                      size_t aad_len, size_t length, uint8_t* tag)
+{
+  uint8_t block[AES_BLOCKLEN];
+  uint8_t i;
+
+  PutBE64(block, (uint64_t)length * 8);
+  PutBE64(block + 8, (uint64_t)aad_len * 8);
+  GhashBlocks(H, X, block, 1);
+
+  PutBE64(block, X[0]);
+  PutBE64(block + 8, X[1]);
+  ReverseBlock(tag, block);
+  for (i = 0; i < 12; ++i)
+  {
+    tag[i] ^= nonce[i];
+  }
+  tag[AES_BLOCKLEN - 1] &= 0x7f;
+  Cipher((state_t*)tag, enc->RoundKey);
+}
+
+// CTR with a 32 bit little-endian counter in the first four bytes of ctr, wrapping around within that field.
+// ctr is left at the first counter not used, a trailing partial block consumes a whole counter.
+static void GcmSivCtr(const struct AES_ctx* enc, uint8_t* ctr, uint8_t* buf, size_t length)
+{
+  state_t stream[AES_LANES];
+  uint32_t c = (uint32_t)ctr[0] | ((uint32_t)ctr[1] << 8) | ((uint32_t)ctr[2] << 16) | ((uint32_t)ctr[3] << 24);
+  size_t i, n, len;
+
+  while (length > 0)
+  {
+    for (n = 0; (n < AES_LANES) && (n * AES_BLOCKLEN < length); ++n, ++c)
+    {
+      ctr[0] = (uint8_t)c;
+      ctr[1] = (uint8_t)(c >> 8);
+      ctr[2] = (uint8_t)(c >> 16);
+      ctr[3] = (uint8_t)(c >> 24);
+      memcpy(&stream[n], ctr, AES_BLOCKLEN);
+    }
+    CipherBlocks(stream, n, enc->RoundKey);
+
+    len = (length < n * AES_BLOCKLEN) ? length : n * AES_BLOCKLEN;
+    for (i = 0; i < len; ++i)
+    {
+      buf[i] ^= ((const uint8_t*)stream)[i];
+    }
+    buf += len;
+    length -= len;
+  }
+  ctr[0] = (uint8_t)c;
+  ctr[1] = (uint8_t)(c >> 8);
+  ctr[2] = (uint8_t)(c >> 16);
+  ctr[3] = (uint8_t)(c >> 24);
+}
+
+void AES_GCM_SIV_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                uint8_t* buf, size_t length, uint8_t* tag)
+{
+  struct AES_ctx enc;
+  ghashKey_t H;
+  uint64_t X[2] = { 0, 0 };
+  uint8_t ctr[AES_BLOCKLEN];
+
+  GcmSivKeys(ctx, nonce, &H, &enc);
+  PolyvalPadded(&H, X, aad, aad_len);
+  PolyvalPadded(&H, X, buf, length);
+  GcmSivTag(&enc, &H, X, nonce, aad_len, length, tag);
+
+  memcpy(ctr, tag, AES_BLOCKLEN);
+  ctr[AES_BLOCKLEN - 1] |= 0x80;
+  GcmSivCtr(&enc, ctr, buf, length);
+}
+
+// The plaintext has to be recovered before it can be hashed, so CTR and POLYVAL are stitched per chunk as in GCM.
+int AES_GCM_SIV_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                               uint8_t* buf, size_t length, const uint8_t* tag)
+{
+  struct AES_ctx enc;
+  ghashKey_t H;
+  uint64_t X[2] = { 0, 0 };
+  uint8_t ctr[AES_BLOCKLEN], full[AES_BLOCKLEN];
+  size_t i, n;
+
+  GcmSivKeys(ctx, nonce, &H, &enc);
+  PolyvalPadded(&H, X, aad, aad_len);
+
+  memcpy(ctr, tag, AES_BLOCKLEN);
+  ctr[AES_BLOCKLEN - 1] |= 0x80;
+  for (i = 0; i < length; i += n)
+  {
+    n = (length - i < GHASH_STRIDE * AES_BLOCKLEN) ? length - i : GHASH_STRIDE * AES_BLOCKLEN;
+    GcmSivCtr(&enc, ctr, buf + i, n);
+    PolyvalPadded(&H, X, buf + i, n);
+  }
+
+  GcmSivTag(&enc, &H, X, nonce, aad_len, length, full);
+  if (TagsDiffer(full, tag, AES_BLOCKLEN))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+#endif // #if defined(GCM_SIV) && (GCM_SIV == 1)
+
+
+
+#if defined(SIV) && (SIV == 1)
+
+void AES_SIV_init_ctx(struct AES_SIV_ctx* ctx, const uint8_t* key)
+{
+  uint8_t zero[AES_BLOCKLEN] = { 0 };
+  size_t len = AES_BLOCKLEN;
+  const uint8_t* msg = zero;
+
+  CmacInit(&ctx->mac, key);
+  AES_init_ctx(&ctx->ctr, key + AES_KEYLEN);
+  CmacMessages(&ctx->mac, &msg, &len, 0, 1, ctx->Z);
+}
+
+// S2V state after the associated data, where aad_len 0 stands for no associated data
+static void SivHeader(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len, uint8_t* D)
+{
+  uint8_t mac[AES_BLOCKLEN];
+
+  memcpy(D, ctx->Z, AES_BLOCKLEN);
+  if (aad_len > 0)
+  {
+    CmacMessages(&ctx->mac, &aad, &aad_len, 0, 1, mac);
+    DoubleBlock(D, D);
+    XorBlock(D, mac);
+  }
+}
+
+// Computes the synthetic IVs of count <= AES_LANES messages sharing the S2V state D, running their CMACs side by side.
+// A message of a block or more is hashed in place with D XOR'ed into its last block, which is undone afterwards.
+// A shorter message is padded into T and XOR'ed with D doubled.
+static void SivTags(const struct AES_SIV_ctx* ctx, const uint8_t* D, uint8_t* const* bufs, const size_t* lengths,
+                    size_t count, uint8_t* tags)
+{
+  uint8_t T[AES_LANES][AES_BLOCKLEN];
+  const uint8_t* msgs[AES_LANES];
+  size_t lens[AES_LANES];
+  size_t i, j;
+
+  for (j = 0; j < count; ++j)
+  {
+    if (lengths[j] >= AES_BLOCKLEN)
+    {
+      XorBlock(bufs[j] + lengths[j] - AES_BLOCKLEN, D);
+      msgs[j] = bufs[j];
+      lens[j] = lengths[j];
+    }
+    else
+    {
+      DoubleBlock(T[j], D);
+      for (i = 0; i < lengths[j]; ++i)
+      {
+        T[j][i] ^= bufs[j][i];
+      }
+      T[j][lengths[j]] ^= 0x80;
+      msgs[j] = T[j];
+      lens[j] = AES_BLOCKLEN;
+    }
+  }
+
+  CmacMessages(&ctx->mac, msgs, lens, 0, count, tags);
+
+  for (j = 0; j < count; ++j)
+  {
+    if (lengths[j] >= AES_BLOCKLEN)
+    {
+      XorBlock(bufs[j] + lengths[j] - AES_BLOCKLEN, D);
+    }
+  }
+}
+
+// Encrypts the n counter blocks in stream and XORs them into the len[j] bytes at dst[j]
+static void SivXorStream(const struct AES_ctx* ctx, state_t* stream, uint8_t* const* dst, const size_t* len, size_t n)
+{
+  size_t i, j;
+
+  CipherBlocks(stream, n, ctx->RoundKey);
+  for (j = 0; j < n; ++j)
+  {
+    for (i = 0; i < len[j]; ++i)
+    {
+      dst[j][i] ^= ((const uint8_t*)&stream[j])[i];
+    }
+  }
+}
+
+// XORs the CTR keystream of count messages into their buffers, the initial counter of each being its
+// synthetic IV with bits 63 and 31 cleared. The lanes of every CipherBlocks() call are filled with
+// blocks from consecutive messages, so short messages don't leave lanes idle.
+static void SivCtr(const struct AES_ctx* ctx, const uint8_t* tags, uint8_t* const* bufs, const size_t* lengths,
+                   size_t count)
+{
+  state_t stream[AES_LANES];
+  uint8_t* dst[AES_LANES];
+  size_t len[AES_LANES];
+  uint8_t ctr[AES_BLOCKLEN];
+  size_t m, off, n = 0;
+
+  for (m = 0; m < count; ++m)
+  {
+    memcpy(ctr, tags + m * AES_BLOCKLEN, AES_BLOCKLEN);
+    ctr[8] &= 0x7f;
+    ctr[12] &= 0x7f;
+    for (off = 0; off < lengths[m]; off += AES_BLOCKLEN)
+    {
+      memcpy(&stream[n], ctr, AES_BLOCKLEN);
+      IncrementCounter(ctr, AES_BLOCKLEN);
+      dst[n] = bufs[m] + off;
+      len[n] = (lengths[m] - off < AES_BLOCKLEN) ? lengths[m] - off : AES_BLOCKLEN;
+      if (++n == AES_LANES)
+      {
+        SivXorStream(ctx, stream, dst, len, n);
+        n = 0;
+      }
+    }
+  }
+  SivXorStream(ctx, stream, dst, len, n);
+}
+
+void AES_SIV_encrypt_buffer(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                            uint8_t* buf, size_t length, uint8_t* tag)
+{
+  uint8_t D[AES_BLOCKLEN];
+
+  SivHeader(ctx, aad, aad_len, D);
+  SivTags(ctx, D, &buf, &length, 1, tag);
+  SivCtr(&ctx->ctr, tag, &buf, &length, 1);
+}
+
+int AES_SIV_decrypt_buffer(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                           uint8_t* buf, size_t length, const uint8_t* tag)
+{
+  uint8_t D[AES_BLOCKLEN], full[AES_BLOCKLEN];
+
+  SivCtr(&ctx->ctr, tag, &buf, &length, 1);
+  SivHeader(ctx, aad, aad_len, D);
+  SivTags(ctx, D, &buf, &length, 1, full);
+  if (TagsDiffer(full, tag, AES_BLOCKLEN))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+// The S2V state after the shared associated data is computed once for the whole batch
+void AES_SIV_encrypt_buffers(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                             uint8_t* const* bufs, const size_t* lengths, size_t count, uint8_t* tags)
+{
+  uint8_t D[AES_BLOCKLEN];
+  size_t n;
+
+  SivHeader(ctx, aad, aad_len, D);
+  for (; count > 0; count -= n, bufs += n, lengths += n, tags += n * AES_BLOCKLEN)
+  {
+    n = (count < AES_LANES) ? count : AES_LANES;
+    SivTags(ctx, D, bufs, lengths, n, tags);
+    SivCtr(&ctx->ctr, tags, bufs, lengths, n);
+  }
+}
+
+#endif // #if defined(SIV) && (SIV == 1)
+
+
+
+#if defined(KW) && (KW == 1)
+
+static const uint8_t KwIv[8] = { 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6 };
+static const uint8_t KwpIv[4] = { 0xa6, 0x59, 0x59, 0xa6 };
+
+// Number of cipher calls of a chain over n 64 bit blocks. One block is a single encryption of A | R (RFC 5649).
+static size_t KwSteps(size_t n)
+{
+  return (n == 1) ? 1 : 6 * n;
+}
+
+// Runs the wrapping (W) or unwrapping (W^-1) chains of count <= AES_LANES keys side by side, one step of
+// every chain per cipher call. A[k] is the 8 byte integrity check register and R[k] the n[k] 64 bit blocks of key k.
+static void KwChains(const roundKey_t* RoundKey, uint8_t* const* A, uint8_t* const* R, const size_t* n,
+                     size_t count, uint8_t encrypt)
+{
+  state_t B[AES_LANES];
+  size_t lane[AES_LANES], t[AES_LANES];
+  size_t j, k, m, s, steps = 0;
+  uint8_t b;
+
+  for (k = 0; k < count; ++k)
+  {
+    steps = (KwSteps(n[k]) > steps) ? KwSteps(n[k]) : steps;
+  }
+
+  for (s = 0; s < steps; ++s)
+  {
+    // Gather the chains still running. t = n * j + i counts the steps from 1, unwrapping runs them backwards.
+    for (k = 0, m = 0; k < count; ++k)
+    {
+      if (s < KwSteps(n[k]))
+      {
+        lane[m] = k;
+        t[m] = encrypt ? s + 1 : KwSteps(n[k]) - s;
+        memcpy(&B[m], A[k], 8);
+        memcpy((uint8_t*)&B[m] + 8, R[k] + 8 * ((t[m] - 1) % n[k]), 8);
+        if (!encrypt && (n[k] > 1))
+        {
+          for (b = 0; b < 8; ++b)
+          {
+            ((uint8_t*)&B[m])[7 - b] ^= (uint8_t)(t[m] >> (8 * b));
+          }
+        }
+        ++m;
+      }
+    }
+
+    if (encrypt)
+    {
+      CipherBlocks(B, m, RoundKey);
+    }
+    else
+    {
+      InvCipherBlocks(B, m, RoundKey);
+    }
+
+    for (j = 0; j < m; ++j)
+    {
+      k = lane[j];
+      if (encrypt && (n[k] > 1))
+      {
+        for (b = 0; b < 8; ++b)
+        {
+          ((uint8_t*)&B[j])[7 - b] ^= (uint8_t)(t[j] >> (8 * b));
+        }
+      }
+      memcpy(A[k], &B[j], 8);
+      memcpy(R[k] + 8 * ((t[j] - 1) % n[k]), (uint8_t*)&B[j] + 8, 8);
+    }
+  }
+}
+
+// Checks the integrity check register and padding of an unwrapped key, returns non-zero if they are invalid.
+// For KWP, *length is set to the length of the key without the padding.
+static uint8_t KwCheck(const uint8_t* A, const uint8_t* R, size_t* length, uint8_t padded)
+{
+  size_t mli, i;
+  uint8_t diff;
+
+  if (!padded)
+  {
+    return TagsDiffer(A, KwIv, 8);
+  }
+
+  diff = TagsDiffer(A, KwpIv, 4);
+  mli = ((size_t)A[4] << 24) | ((size_t)A[5] << 16) | ((size_t)A[6] << 8) | A[7];
+  if ((mli + 8 <= *length) || (mli > *length))
+  {
+    return 1;
+  }
+  for (i = mli; i < *length; ++i)
+  {
+    diff |= R[i];
+  }
+  *length = mli;
+  return diff;
+}
+
+// Wrapped keys are whole semiblocks: at least 3 with KW (RFC 3394), 2 with KWP (RFC 5649)
+static uint8_t KwLengthValid(size_t length, uint8_t padded)
+{
+  return (length % 8 == 0) && (length >= (padded ? 16u : 24u));
+}
+
+void AES_KW_wrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out)
+{
+  uint8_t* A = out;
+  uint8_t* R = out + 8;
+  size_t n = length / 8;
+
+  if (!KwLengthValid(length + 8, 0))
+  {
+    return;
+  }
+  memmove(R, in, length);
+  memcpy(A, KwIv, 8);
+  KwChains(ctx->RoundKey, &A, &R, &n, 1, 1);
+}
+
+int AES_KW_unwrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out)
+{
+  uint8_t a[8];
+  uint8_t* A = a;
+  size_t n = length / 8 - 1;
+
+  if (!KwLengthValid(length, 0))
+  {
+    return 1;
+  }
+  memcpy(a, in, 8);
+  memmove(out, in + 8, length - 8);
+  KwChains(ctx->RoundKey, &A, &out, &n, 1, 0);
+  length -= 8;
+  if (KwCheck(a, out, &length, 0))
+  {
+    memset(out, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+void AES_KWP_wrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out)
+{
+  uint8_t* A = out;
+  uint8_t* R = out + 8;
+  size_t n = (length + 7) / 8;
+
+  // RFC 5649: 1 <= length < 2^32, the length being stored in 32 bits
+  if ((length == 0) || ((length >> 16 >> 16) != 0))
+  {
+    return;
+  }
+  memmove(R, in, length);
+  memset(R + length, 0, 8 * n - length);
+  memcpy(A, KwpIv, 4);
+  A[4] = (uint8_t)(length >> 24);
+  A[5] = (uint8_t)(length >> 16);
+  A[6] = (uint8_t)(length >> 8);
+  A[7] = (uint8_t)length;
+  KwChains(ctx->RoundKey, &A, &R, &n, 1, 1);
+}
+
+int AES_KWP_unwrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out, size_t* out_len)
+{
+  uint8_t a[8];
+  uint8_t* A = a;
+  size_t n = length / 8 - 1;
+
+  if (!KwLengthValid(length, 1))
+  {
+    *out_len = 0;
+    return 1;
+  }
+  memcpy(a, in, 8);
+  memmove(out, in + 8, length - 8);
+  KwChains(ctx->RoundKey, &A, &out, &n, 1, 0);
+  *out_len = length - 8;
+  if (KwCheck(a, out, out_len, 1))
+  {
+    memset(out, 0, length - 8);
+    *out_len = 0;
+    return 1;
+  }
+  return 0;
+}
+
+// Unwraps AES_LANES keys at a time under the old KEK, then wraps them again under the new one.
+// The integrity check register is kept, so a KWP key keeps its length and padding.
+static int KwRewrap(const struct AES_ctx* old_kek, const struct AES_ctx* new_kek, uint8_t* const* bufs,
+                    const size_t* lengths, size_t count, uint8_t padded)
+{
+  uint8_t* A[AES_LANES];
+  uint8_t* R[AES_LANES];
+  size_t n[AES_LANES];
+  size_t j, m, len;
+  int failed = 0;
+
+  for (; count > 0; count -= m, bufs += m, lengths += m)
+  {
+    m = (count < AES_LANES) ? count : AES_LANES;
+    for (j = 0; j < m; ++j)
+    {
+      A[j] = bufs[j];
+      R[j] = bufs[j] + 8;
+      n[j] = KwLengthValid(lengths[j], padded) ? lengths[j] / 8 - 1 : 0;
+    }
+    KwChains(old_kek->RoundKey, A, R, n, m, 0);
+    for (j = 0; j < m; ++j)
+    {
+      len = lengths[j] - 8;
+      if ((n[j] == 0) || KwCheck(A[j], R[j], &len, padded))
+      {
+        // Leave the wiped buffer out of the chains below
+        memset(bufs[j], 0, lengths[j]);
+        n[j] = 0;
+        failed = 1;
+      }
+    }
+    KwChains(new_kek->RoundKey, A, R, n, m, 1);
+  }
+  return failed;
+}
+
+int AES_KW_rewrap_buffers(const struct AES_ctx* old_kek, const struct AES_ctx* new_kek, uint8_t* const* bufs,
+                          const size_t* lengths, size_t count)
+{
+  return KwRewrap(old_kek, new_kek, bufs, lengths, count, 0);
+}
+
+int AES_KWP_rewrap_buffers(const struct AES_ctx* old_kek, const struct AES_ctx* new_kek, uint8_t* const* bufs,
+                           const size_t* lengths, size_t count)
+{
+  return KwRewrap(old_kek, new_kek, bufs, lengths, count, 1);
+}
+
+#endif // #if defined(KW) && (KW == 1)
+
+
+
+#if defined(EAX) && (EAX == 1)
+
+void AES_EAX_init_ctx(struct AES_EAX_ctx* ctx, const uint8_t* key)
+{
+  uint8_t t;
+
+  CmacInit(&ctx->mac, key);
+  memset(ctx->L, 0, sizeof(ctx->L));
+  for (t = 0; t < 3; ++t)
+  {
+    ctx->L[t][AES_BLOCKLEN - 1] = t;
+  }
+  CipherBlocks((state_t*)ctx->L, 3, ctx->mac.aes.RoundKey);
+}
+
+// OMAC^t(msg) for the tweaks t listed in tweaks, computed side by side. A non-empty message continues from the
+// precomputed chain L[t]. An empty one is the CMAC of the tweak block alone.
+static void EaxOmacs(const struct AES_EAX_ctx* ctx, const uint8_t* const* msgs, const size_t* lengths,
+                     const uint8_t* tweaks, size_t count, uint8_t* macs)
+{
+  uint8_t blocks[3][AES_BLOCKLEN];
+  uint8_t start[3][AES_BLOCKLEN];
+  const uint8_t* m[3];
+  size_t len[3];
+  size_t j;
+
+  for (j = 0; j < count; ++j)
+  {
+    if (lengths[j] > 0)
+    {
+      memcpy(start[j], ctx->L[tweaks[j]], AES_BLOCKLEN);
+      m[j] = msgs[j];
+      len[j] = lengths[j];
+    }
+    else
+    {
+      memset(start[j], 0, AES_BLOCKLEN);
+      memset(blocks[j], 0, AES_BLOCKLEN);
+      blocks[j][AES_BLOCKLEN - 1] = tweaks[j];
+      m[j] = blocks[j];
+      len[j] = AES_BLOCKLEN;
+    }
+  }
+  CmacMessages(&ctx->mac, m, len, start[0], count, macs);
+}
+
+// Encrypts or decrypts buf and computes the full 16 byte tag.
+// CTR and OMAC over the ciphertext run in one pass, every CipherBlocks() call taking one keystream block and
+// one OMAC block. When encrypting, the OMAC lags one block behind, as its input is the ciphertext just produced.
+static void EaxCrypt(const struct AES_EAX_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                     uint8_t encrypt, uint8_t* tag)
+{
+  static const uint8_t tweaks[3] = { 0, 1, 2 };
+  const uint8_t* msgs[2];
+  size_t lens[2];
+  uint8_t NH[2][AES_BLOCKLEN];
+  uint8_t ctr[AES_BLOCKLEN];
+  state_t s[2];
+  size_t i, pos = 0, nblocks = (length + AES_BLOCKLEN - 1) / AES_BLOCKLEN;
+  uint8_t bi, n, len, mac;
+
+  // The OMACs of nonce and header don't depend on each other, so they are run side by side
+  msgs[0] = nonce;
+  lens[0] = nonce_len;
+  msgs[1] = aad;
+  lens[1] = aad_len;
+  EaxOmacs(ctx, msgs, lens, tweaks, 2, NH[0]);
+
+  if (length == 0)
+  {
+    EaxOmacs(ctx, msgs, &length, tweaks + 2, 1, tag);
+  }
+  else
+  {
+    memcpy(ctr, NH[0], AES_BLOCKLEN);
+    memcpy(tag, ctx->L[2], AES_BLOCKLEN);
+    for (i = 0; i <= nblocks; ++i)
+    {
+      n = 0;
+      if (i < nblocks)
+      {
+        memcpy(&s[n++], ctr, AES_BLOCKLEN);
+        IncrementCounter(ctr, AES_BLOCKLEN);
+      }
+      // The ciphertext block absorbed in this step: block i - 1 when encrypting, block i when decrypting
+      mac = encrypt ? (i > 0) : (i < nblocks);
+      if (mac)
+      {
+        CmacAbsorb(&ctx->mac, tag, buf, length, &pos);
+        memcpy(&s[n++], tag, AES_BLOCKLEN);
+      }
+      CipherBlocks(s, n, ctx->mac.aes.RoundKey);
+      if (mac)
+      {
+        memcpy(tag, &s[n - 1], AES_BLOCKLEN);
+      }
+      if (i < nblocks)
+      {
+        len = (length - i * AES_BLOCKLEN < AES_BLOCKLEN) ? (uint8_t)(length - i * AES_BLOCKLEN) : AES_BLOCKLEN;
+        for (bi = 0; bi < len; ++bi)
+        {
+          buf[i * AES_BLOCKLEN + bi] ^= ((const uint8_t*)&s[0])[bi];
+        }
+      }
+    }
+  }
+
+  XorBlock(tag, NH[0]);
+  XorBlock(tag, NH[1]);
+}
+
+// Shorter tags give too little protection against forgeries to be worth accepting
+#define EAX_MIN_TAG_LEN 4
+
+void AES_EAX_encrypt_buffer(const struct AES_EAX_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if ((tag_len < EAX_MIN_TAG_LEN) || (tag_len > AES_BLOCKLEN))
+  {
+    return;
+  }
+  EaxCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, 1, full);
+  memcpy(tag, full, tag_len);
+}
+
+int AES_EAX_decrypt_buffer(const struct AES_EAX_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[AES_BLOCKLEN];
+
+  if ((tag_len < EAX_MIN_TAG_LEN) || (tag_len > AES_BLOCKLEN))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  EaxCrypt(ctx, nonce, nonce_len, aad, aad_len, buf, length, 0, full);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+#endif // #if defined(EAX) && (EAX == 1)
+
+
+#if defined(DRBG) && (DRBG == 1)
+
+#define DRBG_CHAINS ((AES_DRBG_SEEDLEN + AES_BLOCKLEN - 1) / AES_BLOCKLEN) // blocks of cipher output per seed
+
+// Block_Cipher_df (SP 800-90A 10.3.2) of the concatenated inputs, returning AES_DRBG_SEEDLEN bytes at seed.
+// The BCC chains differ only in their first block, so all of them absorb S = L || N || input || 0x80 || 0...
+// side by side, one CipherBlocks() call per block. S is assembled block by block from the inputs.
+static void DrbgDerive(const uint8_t* const* in, const size_t* in_len, size_t count, uint8_t* seed)
+{
+  static const uint8_t K[32] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+  roundKey_t RoundKey[AES_keyExpSize];
+  state_t X[DRBG_CHAINS];
+  uint8_t header[8];
+  uint8_t block[AES_BLOCKLEN];
+  size_t total = 0, j = 0, off = 0, slen, pos, p;
+  uint8_t bi;
+
+  for (j = 0; j < count; ++j)
+  {
+    total += in_len[j];
+  }
+  header[0] = (uint8_t)(total >> 24);
+  header[1] = (uint8_t)(total >> 16);
+  header[2] = (uint8_t)(total >> 8);
+  header[3] = (uint8_t)total;
+  header[4] = 0;
+  header[5] = 0;
+  header[6] = 0;
+  header[7] = AES_DRBG_SEEDLEN;
+  slen = (8 + total + AES_BLOCKLEN) / AES_BLOCKLEN * AES_BLOCKLEN;
+
+  // BCC of the first block alone, IV = j || 0^96
+  KeyExpansion(RoundKey, K);
+  memset(X, 0, sizeof(X));
+  for (j = 0; j < DRBG_CHAINS; ++j)
+  {
+    X[j].a[0][3] = (uint8_t)j;
+  }
+  CipherBlocks(X, DRBG_CHAINS, RoundKey);
+
+  j = 0;
+  for (pos = 0; pos < slen; pos += AES_BLOCKLEN)
+  {
+    for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+    {
+      p = pos + bi;
+      if (p < 8)
+      {
+        block[bi] = header[p];
+      }
+      else if (p < 8 + total)
+      {
+        while (off == in_len[j])
+        {
+          ++j;
+          off = 0;
+        }
+        block[bi] = in[j][off++];
+      }
+      else
+      {
+        block[bi] = (p == 8 + total) ? 0x80 : 0;
+      }
+    }
+    for (p = 0; p < DRBG_CHAINS; ++p)
+    {
+      XorBlock((uint8_t*)&X[p], block);
+    }
+    CipherBlocks(X, DRBG_CHAINS, RoundKey);
+  }
+
+  // The chains give the key and the first block X, which is then encrypted in a chain of its own
+  KeyExpansion(RoundKey, (const uint8_t*)X);
+  memcpy(block, (const uint8_t*)X + AES_KEYLEN, AES_BLOCKLEN);
+  for (pos = 0; pos < AES_DRBG_SEEDLEN; pos += AES_BLOCKLEN)
+  {
+    Cipher((state_t*)block, RoundKey);
+    memcpy(seed + pos, block, (AES_DRBG_SEEDLEN - pos < AES_BLOCKLEN) ? AES_DRBG_SEEDLEN - pos : AES_BLOCKLEN);
+  }
+}
+
+// The seed material of the inputs: their derivation, or without derivation function, their XOR.
+// Returns 1 if an input is longer than AES_DRBG_SEEDLEN without derivation function.
+static uint8_t DrbgSeedMaterial(uint8_t df, const uint8_t* const* in, const size_t* in_len, size_t count, uint8_t* seed)
+{
+  size_t i, j;
+
+  if (df)
+  {
+    DrbgDerive(in, in_len, count, seed);
+    return 0;
+  }
+  for (j = 0; j < count; ++j)
+  {
+    if (in_len[j] > AES_DRBG_SEEDLEN)
+    {
+      return 1;
+    }
+  }
+  memset(seed, 0, AES_DRBG_SEEDLEN);
+  for (j = 0; j < count; ++j)
+  {
+    for (i = 0; i < in_len[j]; ++i)
+    {
+      seed[i] ^= in[j][i];
+    }
+  }
+  return 0;
+}
+
+// CTR_DRBG_Update: the next AES_DRBG_SEEDLEN bytes of keystream, XORed with the provided data, become Key and V.
+static void DrbgUpdate(struct AES_DRBG_ctx* ctx, const uint8_t* provided)
+{
+  uint8_t temp[DRBG_CHAINS * AES_BLOCKLEN];
+
+  memcpy(temp, provided, AES_DRBG_SEEDLEN);
+  CtrStream(ctx->aes.RoundKey, ctx->V, AES_BLOCKLEN, temp, AES_DRBG_SEEDLEN, CTR_XOR);
+  KeyExpansion(ctx->aes.RoundKey, temp);
+  memcpy(ctx->V, temp + AES_KEYLEN, AES_BLOCKLEN);
+  IncrementCounter(ctx->V, AES_BLOCKLEN);
+}
+
+static int DrbgSeed(struct AES_DRBG_ctx* ctx, const uint8_t* const* in, const size_t* in_len, size_t count)
+{
+  uint8_t seed[AES_DRBG_SEEDLEN];
+
+  if (DrbgSeedMaterial(ctx->df, in, in_len, count, seed))
+  {
+    return 1;
+  }
+  DrbgUpdate(ctx, seed);
+  ctx->reseed_counter = 1;
+#if DRBG_FORK_DETECT
+  ctx->pid = (long)getpid();
+#endif
+  return 0;
+}
+
+// An instance that could not be seeded refuses to generate until it is reseeded
+static int DrbgInit(struct AES_DRBG_ctx* ctx, uint8_t df, const uint8_t* const* in, const size_t* in_len, size_t count)
+{
+  uint8_t zero[AES_KEYLEN];
+
+  memset(zero, 0, AES_KEYLEN);
+  KeyExpansion(ctx->aes.RoundKey, zero);
+  memset(ctx->V, 0, AES_BLOCKLEN);
+  ctx->V[AES_BLOCKLEN - 1] = 1;
+  ctx->df = df;
+  ctx->reseed_counter = AES_DRBG_RESEED_INTERVAL + 1;
+#if DRBG_FORK_DETECT
+  ctx->pid = (long)getpid();
+#endif
+  return DrbgSeed(ctx, in, in_len, count);
+}
+
+void AES_DRBG_init_ctx(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, size_t entropy_len,
+                       const uint8_t* nonce, size_t nonce_len, const uint8_t* pers, size_t pers_len)
+{
+  const uint8_t* in[3];
+  size_t len[3];
+
+  in[0] = entropy;
+  len[0] = entropy_len;
+  in[1] = nonce;
+  len[1] = nonce_len;
+  in[2] = pers;
+  len[2] = pers_len;
+  (void)DrbgInit(ctx, 1, in, len, 3);
+}
+
+int AES_DRBG_init_ctx_no_df(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* pers, size_t pers_len)
+{
+  const uint8_t* in[2];
+  size_t len[2];
+
+  in[0] = entropy;
+  len[0] = AES_DRBG_SEEDLEN;
+  in[1] = pers;
+  len[1] = pers_len;
+  return DrbgInit(ctx, 0, in, len, 2);
+}
+
+int AES_DRBG_reseed(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, size_t entropy_len,
+                    const uint8_t* additional, size_t add_len)
+{
+  const uint8_t* in[2];
+  size_t len[2];
+
+  in[0] = entropy;
+  len[0] = entropy_len;
+  in[1] = additional;
+  len[1] = add_len;
+  return DrbgSeed(ctx, in, len, 2);
+}
+
+// The output of each request is the keystream of CTR mode from V, generated AES_LANES blocks at a time.
+int AES_DRBG_generate(struct AES_DRBG_ctx* ctx, uint8_t* out, size_t length, const uint8_t* additional, size_t add_len)
+{
+  uint8_t add[AES_DRBG_SEEDLEN];
+  size_t n = (length + AES_DRBG_MAX_REQUEST - 1) / AES_DRBG_MAX_REQUEST; // requests, an empty one counting as one
+
+#if DRBG_FORK_DETECT
+  if (ctx->pid != (long)getpid())
+  {
+    return 1;
+  }
+#endif
+  if (ctx->reseed_counter + n - (n > 0) > AES_DRBG_RESEED_INTERVAL)
+  {
+    return 1;
+  }
+
+  memset(add, 0, AES_DRBG_SEEDLEN);
+  if (add_len > 0)
+  {
+    if (DrbgSeedMaterial(ctx->df, &additional, &add_len, 1, add))
+    {
+      return 1;
+    }
+    DrbgUpdate(ctx, add);
+  }
+  do
+  {
+    n = (length < AES_DRBG_MAX_REQUEST) ? length : AES_DRBG_MAX_REQUEST;
+    CtrStream(ctx->aes.RoundKey, ctx->V, AES_BLOCKLEN, out, n, CTR_STORE);
+    DrbgUpdate(ctx, add);
+    memset(add, 0, AES_DRBG_SEEDLEN);
+    ++ctx->reseed_counter;
+    out += n;
+    length -= n;
+  } while (length > 0);
+  return 0;
+}
+
+#endif // #if defined(DRBG) && (DRBG == 1)
+
+
+#if defined(FPE) && (FPE == 1)
+
+#define FF1_MAX_B ((AES_FPE_MAX_LEN + 1) / 2)                             // bytes of NUM_radix(B), one per digit at most
+#define FF1_MAX_D (4 * ((FF1_MAX_B + 3) / 4) + 4)                         // bytes of S
+#define FF1_S_BLOCKS ((FF1_MAX_D + AES_BLOCKLEN - 1) / AES_BLOCKLEN)
+
+#define FPE_WORDS (((FF1_MAX_D > AES_BLOCKLEN) ? FF1_MAX_D : AES_BLOCKLEN) / 4) // 32 bit words of the numbers below
+
+// Digits are converted e at a time, as one number below radix^e, the largest power of radix in 32 bits.
+// This keeps the multi-precision passes few, as each pass is a multiplication or a division of the whole number.
+static uint32_t FpeChunk(unsigned radix, size_t max, size_t* e)
+{
+  uint32_t p = radix;
+
+  *e = 1;
+  while ((*e < max) && (p <= 0xffffffffU / radix))
+  {
+    p *= radix;
+    ++*e;
+  }
+  return p;
+}
+
+// NUM_radix: the value of the numeral string X of n digits, as a big-endian number of len bytes.
+// FF3-1 reads its strings reversed (NUM_radix(REV(X))), which rev selects.
+static void FpeNum(const uint8_t* X, size_t n, uint8_t rev, unsigned radix, uint8_t* num, size_t len)
+{
+  uint32_t w[FPE_WORDS];
+  size_t nw = (len + 3) / 4, i, j, e;
+  uint32_t p, c;
+  uint64_t t;
+
+  memset(w, 0, sizeof(w));
+  for (i = 0; i < n; i += e)
+  {
+    p = FpeChunk(radix, n - i, &e);
+    c = 0;
+    for (j = i; j < i + e; ++j)
+    {
+      c = c * radix + (rev ? X[n - 1 - j] : X[j]);
+    }
+    for (j = nw; j > 0; --j)
+    {
+      t = (uint64_t)w[j - 1] * p + c;
+      w[j - 1] = (uint32_t)t;
+      c = (uint32_t)(t >> 32);
+    }
+  }
+  for (j = 0; j < len; ++j)
+  {
+    num[len - 1 - j] = (uint8_t)(w[nw - 1 - j / 4] >> (8 * (j % 4)));
+  }
+}
+
+// X = (X + y) mod radix^m, or (X - y) mod radix^m when decrypting, for the big-endian number y of len bytes,
+// len a multiple of 4. Only the low m digits of y matter. They are divided off and added to X with carry, so the
+// sum is never converted back from binary. With rev the least significant digit of X comes first.
+static void FpeAdd(uint8_t* X, size_t m, uint8_t rev, unsigned radix, const uint8_t* y, size_t len, uint8_t decrypt)
+{
+  uint32_t w[FPE_WORDS];
+  size_t nw = len / 4, top = 0, i = 0, j, k, e;
+  uint32_t p, r, q, d, carry = 0;
+  uint64_t t;
+
+  for (j = 0; j < nw; ++j)
+  {
+    w[j] = ((uint32_t)y[4 * j] << 24) | ((uint32_t)y[4 * j + 1] << 16) | ((uint32_t)y[4 * j + 2] << 8) | y[4 * j + 3];
+  }
+  while (i < m)
+  {
+    p = FpeChunk(radix, m - i, &e);
+    r = 0;
+    for (j = top; j < nw; ++j)
+    {
+      t = ((uint64_t)r << 32) | w[j];
+      w[j] = (uint32_t)(t / p);
+      r = (uint32_t)(t % p);
+    }
+    while ((top < nw) && (w[top] == 0))
+    {
+      ++top;
+    }
+
+    for (; e > 0; --e, ++i)
+    {
+      q = r % radix;
+      r /= radix;
+      k = rev ? i : m - 1 - i;
+      if (decrypt)
+      {
+        d = X[k] + radix - q - carry;
+        carry = (d < radix);
+        X[k] = (uint8_t)(carry ? d : d - radix);
+      }
+      else
+      {
+        d = X[k] + q + carry;
+        carry = (d >= radix);
+        X[k] = (uint8_t)(carry ? d - radix : d);
+      }
+    }
+  }
+}
+
+// b = ceil(ceil(v * log2(radix)) / 8), the byte length of radix^v - 1, the largest number of v digits
+static size_t Ff1Bytes(size_t v, unsigned radix)
+{
+  uint8_t digits[FF1_MAX_B];
+  uint8_t num[FF1_MAX_B];
+  size_t i;
+
+  memset(digits, (int)(radix - 1), v);
+  FpeNum(digits, v, 0, radix, num, FF1_MAX_B);
+  for (i = 0; (i < FF1_MAX_B) && (num[i] == 0); ++i)
+  {
+  }
+  return FF1_MAX_B - i;
+}
+
+// Runs the CBC-MAC chains of the PRF over blocks from[k] to to[k] - 1 of Q = T || 0^pad || [round] || [NUM_radix(B)]^b,
+// one CipherBlocks() call per block index across the strings.
+static void Ff1Chains(const roundKey_t* RoundKey, const uint8_t* tweak, size_t t, uint8_t round,
+                      uint8_t numB[][FF1_MAX_B], const size_t* pad, uint8_t chain[][AES_BLOCKLEN],
+                      const size_t* from, const size_t* to, size_t count)
+{
+  state_t s[AES_LANES];
+  size_t lane[AES_LANES];
+  size_t j, k, n, p;
+  uint8_t bi, q;
+
+  for (j = 0; ; ++j)
+  {
+    n = 0;
+    for (k = 0; k < count; ++k)
+    {
+      if (from[k] + j < to[k])
+      {
+        for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+        {
+          p = (from[k] + j) * AES_BLOCKLEN + bi;
+          if (p < t)
+          {
+            q = tweak[p];
+          }
+          else if (p < t + pad[k])
+          {
+            q = 0;
+          }
+          else if (p == t + pad[k])
+          {
+            q = round;
+          }
+          else
+          {
+            q = numB[k][p - t - pad[k] - 1];
+          }
+          ((uint8_t*)&s[n])[bi] = chain[k][bi] ^ q;
+        }
+        lane[n++] = k;
+      }
+    }
+    if (n == 0)
+    {
+      break;
+    }
+    CipherBlocks(s, n, RoundKey);
+    for (k = 0; k < n; ++k)
+    {
+      memcpy(chain[lane[k]], &s[k], AES_BLOCKLEN);
+    }
+  }
+}
+
+// FF1 of count <= AES_LANES numeral strings under the same tweak, their ten Feistel rounds run in lockstep.
+// The blocks of P and the leading blocks of Q that hold only tweak and padding are the same in every round,
+// so their CBC-MAC is computed once and each round continues from it.
+static void Ff1Crypt(const struct AES_ctx* ctx, const uint8_t* tweak, size_t t, unsigned radix,
+                     uint8_t* const* X, const size_t* lengths, size_t count, uint8_t decrypt)
+{
+  state_t s[AES_LANES * FF1_S_BLOCKS];
+  uint8_t pre[AES_LANES][AES_BLOCKLEN];
+  uint8_t chain[AES_LANES][AES_BLOCKLEN];
+  uint8_t numB[AES_LANES][FF1_MAX_B];
+  uint8_t S[AES_LANES][FF1_S_BLOCKS * AES_BLOCKLEN];
+  size_t u[AES_LANES], b[AES_LANES], d[AES_LANES], pad[AES_LANES], first[AES_LANES], last[AES_LANES], zero[AES_LANES];
+  size_t i, j, k, n, half, other;
+  uint8_t r, h, bi;
+
+  memset(s, 0, count * AES_BLOCKLEN);
+  for (k = 0; k < count; ++k)
+  {
+    n = lengths[k];
+    u[k] = n / 2;
+    b[k] = Ff1Bytes(n - u[k], radix);
+    d[k] = 4 * ((b[k] + 3) / 4) + 4;
+    pad[k] = (AES_BLOCKLEN - (t + b[k] + 1) % AES_BLOCKLEN) % AES_BLOCKLEN;
+    first[k] = (t + pad[k]) / AES_BLOCKLEN;
+    last[k] = (t + pad[k] + 1 + b[k]) / AES_BLOCKLEN;
+    zero[k] = 0;
+
+    // P = [1]^1 || [2]^1 || [1]^1 || [radix]^3 || [10]^1 || [u mod 256]^1 || [n]^4 || [t]^4
+    s[k].a[0][0] = 1;
+    s[k].a[0][1] = 2;
+    s[k].a[0][2] = 1;
+    s[k].a[1][0] = (uint8_t)(radix >> 8);
+    s[k].a[1][1] = (uint8_t)radix;
+    s[k].a[1][2] = 10;
+    s[k].a[1][3] = (uint8_t)u[k];
+    for (bi = 0; bi < 4; ++bi)
+    {
+      s[k].a[2][bi] = (uint8_t)(n >> (24 - 8 * bi));
+      s[k].a[3][bi] = (uint8_t)(t >> (24 - 8 * bi));
+    }
+  }
+  CipherBlocks(s, count, ctx->RoundKey);
+  memcpy(pre, s, count * AES_BLOCKLEN);
+  Ff1Chains(ctx->RoundKey, tweak, t, 0, numB, pad, pre, zero, first, count);
+
+  for (i = 0; i < 10; ++i)
+  {
+    // Round r updates the first half (u digits) if even, the second (v digits) if odd, from the other half
+    r = (uint8_t)(decrypt ? 9 - i : i);
+    h = r & 1;
+    for (k = 0; k < count; ++k)
+    {
+      other = h ? 0 : u[k];
+      FpeNum(X[k] + other, h ? u[k] : lengths[k] - u[k], 0, radix, numB[k], b[k]);
+      memcpy(chain[k], pre[k], AES_BLOCKLEN);
+    }
+    Ff1Chains(ctx->RoundKey, tweak, t, r, numB, pad, chain, first, last, count);
+
+    // S = R || CIPH(R ^ [1]^16) || CIPH(R ^ [2]^16) || ..., the blocks after R of all strings in one call
+    n = 0;
+    for (k = 0; k < count; ++k)
+    {
+      memcpy(S[k], chain[k], AES_BLOCKLEN);
+      for (j = 1; j * AES_BLOCKLEN < d[k]; ++j)
+      {
+        memcpy(&s[n], chain[k], AES_BLOCKLEN);
+        s[n++].a[3][3] ^= (uint8_t)j;
+      }
+    }
+    CipherBlocks(s, n, ctx->RoundKey);
+    n = 0;
+    for (k = 0; k < count; ++k)
+    {
+      for (j = 1; j * AES_BLOCKLEN < d[k]; ++j)
+      {
+        memcpy(S[k] + j * AES_BLOCKLEN, &s[n++], AES_BLOCKLEN);
+      }
+      half = h ? u[k] : 0;
+      FpeAdd(X[k] + half, h ? lengths[k] - u[k] : u[k], 0, radix, S[k], d[k], decrypt);
+    }
+  }
+}
+
+// FF3-1 of count <= AES_LANES numeral strings, one block per string in each of the eight rounds
+static void Ff3Crypt(const struct AES_ctx* ctx, const uint8_t* tweak, unsigned radix,
+                     uint8_t* const* X, const size_t* lengths, size_t count, uint8_t decrypt)
+{
+  state_t s[AES_LANES];
+  uint8_t W[2][4];
+  uint8_t P[AES_BLOCKLEN];
+  size_t i, k, u, len;
+  uint8_t r, h, bi;
+
+  // W[0] = TR = T[32..55] || T[28..31] || 0^4 is used in the even rounds, W[1] = TL = T[0..27] || 0^4 in the odd ones
+  W[0][0] = tweak[4];
+  W[0][1] = tweak[5];
+  W[0][2] = tweak[6];
+  W[0][3] = (uint8_t)(tweak[3] << 4);
+  W[1][0] = tweak[0];
+  W[1][1] = tweak[1];
+  W[1][2] = tweak[2];
+  W[1][3] = tweak[3] & 0xf0;
+
+  for (i = 0; i < 8; ++i)
+  {
+    r = (uint8_t)(decrypt ? 7 - i : i);
+    h = r & 1;
+    for (k = 0; k < count; ++k)
+    {
+      // P = (W ^ [r]^4) || [NUM_radix(REV(B))]^12, encrypted as REVB(P)
+      u = (lengths[k] + 1) / 2;
+      memcpy(P, W[h], 4);
+      P[3] ^= r;
+      FpeNum(X[k] + (h ? 0 : u), h ? u : lengths[k] - u, 1, radix, P + 4, AES_BLOCKLEN - 4);
+      for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+      {
+        ((uint8_t*)&s[k])[bi] = P[AES_BLOCKLEN - 1 - bi];
+      }
+    }
+    CipherBlocks(s, count, ctx->RoundKey);
+    for (k = 0; k < count; ++k)
+    {
+      // y = NUM(REVB(output))
+      u = (lengths[k] + 1) / 2;
+      len = h ? lengths[k] - u : u;
+      for (bi = 0; bi < AES_BLOCKLEN; ++bi)
+      {
+        P[bi] = ((const uint8_t*)&s[k])[AES_BLOCKLEN - 1 - bi];
+      }
+      FpeAdd(X[k] + (h ? u : 0), len, 1, radix, P, AES_BLOCKLEN, decrypt);
+    }
+  }
+}
+
+// maxlen of FF3-1 is 2 * floor(log_radix(2^96)), twice the most digits u with radix^u - 1 in 96 bits
+static size_t Ff3MaxLen(unsigned radix)
+{
+  uint32_t w[3] = { 0, 0, 0 };
+  uint32_t c;
+  uint64_t t;
+  size_t u, j;
+
+  for (u = 0; ; ++u)
+  {
+    // radix^(u+1) - 1 = (radix^u - 1) * radix + radix - 1
+    c = radix - 1;
+    for (j = 0; j < 3; ++j)
+    {
+      t = (uint64_t)w[j] * radix + c;
+      w[j] = (uint32_t)t;
+      c = (uint32_t)(t >> 32);
+    }
+    if (c != 0)
+    {
+      return 2 * u;
+    }
+  }
+}
+
+// radix is 2 to 256 and every length between minlen, the least with radix^minlen >= 1000000, and maxlen
+static uint8_t FpeLengthsValid(unsigned radix, const size_t* lengths, size_t count, uint8_t ff3)
+{
+  size_t maxlen, i, k;
+  uint32_t p;
+
+  if ((radix < 2) || (radix > 256))
+  {
+    return 0;
+  }
+  maxlen = ff3 ? Ff3MaxLen(radix) : AES_FPE_MAX_LEN;
+  for (k = 0; k < count; ++k)
+  {
+    if ((lengths[k] < 2) || (lengths[k] > maxlen))
+    {
+      return 0;
+    }
+    for (i = 0, p = 1; (i < lengths[k]) && (p < 1000000); ++i)
+    {
+      p *= radix;
+    }
+    if (p < 1000000)
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static int Ff1CryptBuffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* const* X, const size_t* lengths, size_t count, uint8_t decrypt)
+{
+  size_t i;
+
+  if (!FpeLengthsValid(radix, lengths, count, 0))
+  {
+    return 1;
+  }
+  for (i = 0; i < count; i += AES_LANES)
+  {
+    Ff1Crypt(ctx, tweak, tweak_len, radix, X + i, lengths + i, (count - i < AES_LANES) ? count - i : AES_LANES, decrypt);
+  }
+  return 0;
+}
+
+static int Ff3CryptBuffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* const* X, const size_t* lengths, size_t count, uint8_t decrypt)
+{
+  size_t i;
+
+  if ((tweak_len != 7) || !FpeLengthsValid(radix, lengths, count, 1))
+  {
+    return 1;
+  }
+  for (i = 0; i < count; i += AES_LANES)
+  {
+    Ff3Crypt(ctx, tweak, radix, X + i, lengths + i, (count - i < AES_LANES) ? count - i : AES_LANES, decrypt);
+  }
+  return 0;
+}
+
+int AES_FF1_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length)
+{
+  return Ff1CryptBuffers(ctx, tweak, tweak_len, radix, &X, &length, 1, 0);
+}
+
+int AES_FF1_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length)
+{
+  return Ff1CryptBuffers(ctx, tweak, tweak_len, radix, &X, &length, 1, 1);
+}
+
+int AES_FF1_encrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count)
+{
+  return Ff1CryptBuffers(ctx, tweak, tweak_len, radix, X, lengths, count, 0);
+}
+
+int AES_FF1_decrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count)
+{
+  return Ff1CryptBuffers(ctx, tweak, tweak_len, radix, X, lengths, count, 1);
+}
+
+void AES_FF3_init_ctx(struct AES_ctx* ctx, const uint8_t* key)
+{
+  uint8_t rev[AES_KEYLEN];
+  uint8_t i;
+
+  for (i = 0; i < AES_KEYLEN; ++i)
+  {
+    rev[i] = key[AES_KEYLEN - 1 - i];
+  }
+  AES_init_ctx(ctx, rev);
+}
+
+int AES_FF3_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length)
+{
+  return Ff3CryptBuffers(ctx, tweak, tweak_len, radix, &X, &length, 1, 0);
+}
+
+int AES_FF3_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length)
+{
+  return Ff3CryptBuffers(ctx, tweak, tweak_len, radix, &X, &length, 1, 1);
+}
+
+int AES_FF3_encrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count)
+{
+  return Ff3CryptBuffers(ctx, tweak, tweak_len, radix, X, lengths, count, 0);
+}
+
+int AES_FF3_decrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count)
+{
+  return Ff3CryptBuffers(ctx, tweak, tweak_len, radix, X, lengths, count, 1);
+}
+
+#endif // #if defined(FPE) && (FPE == 1)
+
+
+#if defined(MMO) && (MMO == 1)
+
+// Writes the block at pos of msg padded as in Zigbee: a 1 bit, zeros, and the length in bits as 16 bits, or
+// for messages of 2^16 bits or more as 32 bits followed by 16 zero bits. Returns 1 for the last block.
+static uint8_t MmoBlock(uint8_t* block, const uint8_t* msg, size_t length, size_t pos)
+{
+  size_t bits = length * 8;
+  size_t tail = (bits < 0x10000) ? 2 : 6;
+  size_t padded = (length + 1 + tail + AES_BLOCKLEN - 1) / AES_BLOCKLEN * AES_BLOCKLEN;
+
+  memset(block, 0, AES_BLOCKLEN);
+  if (pos < length)
+  {
+    memcpy(block, msg + pos, (length - pos < AES_BLOCKLEN) ? length - pos : AES_BLOCKLEN);
+  }
+  if ((length >= pos) && (length - pos < AES_BLOCKLEN))
+  {
+    block[length - pos] = 0x80;
+  }
+  if (pos + AES_BLOCKLEN < padded)
+  {
+    return 0;
+  }
+
+  if (tail == 2)
+  {
+    block[14] = (uint8_t)(bits >> 8);
+    block[15] = (uint8_t)bits;
+  }
+  else
+  {
+    block[10] = (uint8_t)(bits >> 24);
+    block[11] = (uint8_t)(bits >> 16);
+    block[12] = (uint8_t)(bits >> 8);
+    block[13] = (uint8_t)bits;
+  }
+  return 1;
+}
+
+// The next AES-128 round key, computed in place from the previous one as in KeyExpansion()
+static inline void MmoNextKey(state_t* k, uint8_t rcon)
+{
+  helper_t temp;
+
+  temp.i = k->i[3];
+  temp.i = ((uint32_t)getSBoxValue(temp.a[1]) << OFS32_BYTE0) |
+           ((uint32_t)getSBoxValue(temp.a[2]) << OFS32_BYTE1) |
+           ((uint32_t)getSBoxValue(temp.a[3]) << OFS32_BYTE2) |
+           ((uint32_t)getSBoxValue(temp.a[0]) << OFS32_BYTE3);
+  temp.a[0] ^= rcon;
+  k->i[0] ^= temp.i;
+  k->i[1] ^= k->i[0];
+  k->i[2] ^= k->i[1];
+  k->i[3] ^= k->i[2];
+}
+
+static inline void MmoXor(state_t* s, const state_t* k)
+{
+  uint8_t i;
+  for (i = 0; i < 4; ++i)
+  {
+    s->i[i] ^= k->i[i];
+  }
+}
+
+// The chaining value of each message is a new AES-128 key for every block. Instead of a KeyExpansion()
+// per block, the round keys are derived on the fly, each just before the round that uses it. Up to
+// AES_LANES messages run side by side, and a lane whose message is done takes the next one at once.
+void AES_MMO_hashes(const uint8_t* const* msgs, const size_t* lengths, size_t count, uint8_t* digests)
+{
+  state_t X[AES_LANES];
+  state_t H[AES_LANES];
+  state_t K[AES_LANES];
+  state_t M[AES_LANES];
+  size_t msg[AES_LANES];
+  size_t pos[AES_LANES];
+  uint8_t last[AES_LANES];
+  size_t next = 0, j, n = 0;
+  uint8_t round;
+
+  for (;;)
+  {
+    for (; (n < AES_LANES) && (next < count); ++n, ++next)
+    {
+      memset(&H[n], 0, AES_BLOCKLEN);
+      msg[n] = next;
+      pos[n] = 0;
+    }
+    if (n == 0)
+    {
+      break;
+    }
+
+    for (j = 0; j < n; ++j)
+    {
+      last[j] = MmoBlock((uint8_t*)&M[j], msgs[msg[j]], lengths[msg[j]], pos[j]);
+      pos[j] += AES_BLOCKLEN;
+      K[j] = H[j];
+      X[j] = M[j];
+      MmoXor(&X[j], &K[j]);
+    }
+    for (round = 1; round < 10; ++round)
+    {
+      for (j = 0; j < n; ++j)
+      {
+        SubBytes(&X[j]);
+        ShiftRows(&X[j]);
+        MixColumns(&X[j]);
+        MmoNextKey(&K[j], getRconValue(round));
+        MmoXor(&X[j], &K[j]);
+      }
+    }
+    for (j = 0; j < n; ++j)
+    {
+      SubBytes(&X[j]);
+      ShiftRows(&X[j]);
+      MmoNextKey(&K[j], getRconValue(10));
+      MmoXor(&X[j], &K[j]);
+      H[j] = X[j];
+      MmoXor(&H[j], &M[j]);
+    }
+
+    // Retire the finished messages, moving the last lane into the freed one
+    for (j = 0; j < n; )
+    {
+      if (last[j])
+      {
+        memcpy(digests + msg[j] * AES_BLOCKLEN, &H[j], AES_BLOCKLEN);
+        --n;
+        H[j] = H[n];
+        msg[j] = msg[n];
+        pos[j] = pos[n];
+        last[j] = last[n];
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
+
+void AES_MMO_hash(const uint8_t* msg, size_t length, uint8_t* digest)
+{
+  AES_MMO_hashes(&msg, &length, 1, digest);
+}
+
+#endif // #if defined(MMO) && (MMO == 1)
+
+
+#if defined(ROUNDS) && (ROUNDS == 1)
+
+#if AES_ROUND_AESNI
+
+void AES_encrypt_round(uint8_t* block, const uint8_t* round_key)
+{
+  __m128i s = _mm_loadu_si128((const __m128i*)block);
+  _mm_storeu_si128((__m128i*)block, _mm_aesenc_si128(s, _mm_loadu_si128((const __m128i*)round_key)));
+}
+
+void AES_encrypt_last_round(uint8_t* block, const uint8_t* round_key)
+{
+  __m128i s = _mm_loadu_si128((const __m128i*)block);
+  _mm_storeu_si128((__m128i*)block, _mm_aesenclast_si128(s, _mm_loadu_si128((const __m128i*)round_key)));
+}
+
+void AES_decrypt_round(uint8_t* block, const uint8_t* round_key)
+{
+  __m128i s = _mm_loadu_si128((const __m128i*)block);
+  _mm_storeu_si128((__m128i*)block, _mm_aesdec_si128(s, _mm_loadu_si128((const __m128i*)round_key)));
+}
+
+void AES_decrypt_last_round(uint8_t* block, const uint8_t* round_key)
+{
+  __m128i s = _mm_loadu_si128((const __m128i*)block);
+  _mm_storeu_si128((__m128i*)block, _mm_aesdeclast_si128(s, _mm_loadu_si128((const __m128i*)round_key)));
+}
+
+void AES_inv_mix_columns(uint8_t* block)
+{
+  _mm_storeu_si128((__m128i*)block, _mm_aesimc_si128(_mm_loadu_si128((const __m128i*)block)));
+}
+
+#else
+
+void AES_encrypt_round(uint8_t* block, const uint8_t* round_key)
+{
+  SubBytes((state_t*)block);
+  ShiftRows((state_t*)block);
+  MixColumns((state_t*)block);
+  XorBlock(block, round_key);
+}
+
+void AES_encrypt_last_round(uint8_t* block, const uint8_t* round_key)
+{
+  SubBytes((state_t*)block);
+  ShiftRows((state_t*)block);
+  XorBlock(block, round_key);
+}
+
+void AES_decrypt_round(uint8_t* block, const uint8_t* round_key)
+{
+  InvShiftRows((state_t*)block);
+  InvSubBytes((state_t*)block);
+  InvMixColumns((state_t*)block);
+  XorBlock(block, round_key);
+}
+
+void AES_decrypt_last_round(uint8_t* block, const uint8_t* round_key)
+{
+  InvShiftRows((state_t*)block);
+  InvSubBytes((state_t*)block);
+  XorBlock(block, round_key);
+}
+
+void AES_inv_mix_columns(uint8_t* block)
+{
+  InvMixColumns((state_t*)block);
+}
+
+#endif // #if AES_ROUND_AESNI
+
+#endif // #if defined(ROUNDS) && (ROUNDS == 1)
+
+
+#if defined(AEGIS) && (AEGIS == 1)
+
+static const uint8_t AegisC0[AES_BLOCKLEN] = {
+  0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x08, 0x0d, 0x15, 0x22, 0x37, 0x59, 0x90, 0xe9, 0x79, 0x62 };
+static const uint8_t AegisC1[AES_BLOCKLEN] = {
+  0xdb, 0x3d, 0x18, 0x55, 0x6d, 0xc2, 0x2f, 0xf1, 0x20, 0x11, 0x31, 0x42, 0x73, 0xb5, 0x28, 0xdd };
+
+// The keystream and the tag are computed the same way by both variants, which differ in the state size n,
+// the rate (2 or 1 blocks) and the update function. The ad and message lengths go in as little-endian bits.
+static block_t AegisLengths(size_t aad_len, size_t length)
+{
+  uint8_t b[AES_BLOCKLEN];
+  uint64_t bits[2];
+  uint8_t i, j;
+
+  bits[0] = (uint64_t)aad_len * 8;
+  bits[1] = (uint64_t)length * 8;
+  for (j = 0; j < 2; ++j)
+  {
+    for (i = 0; i < 8; ++i)
+    {
+      b[8 * j + i] = (uint8_t)(bits[j] >> (8 * i));
+    }
+  }
+  return LoadBlock(b);
+}
+
+// The only tag lengths AEGIS defines
+static inline uint8_t AegisTagLenValid(size_t tag_len)
+{
+  return (tag_len == AES_BLOCKLEN) || (tag_len == 2 * AES_BLOCKLEN);
+}
+
+// Writes the tag_len byte tag: the XOR of the first n16 blocks of the state, or for 32 bytes
+// the XORs of each half of its first n32 blocks.
+static void AegisTag(const block_t* S, uint8_t n16, uint8_t n32, uint8_t* tag, size_t tag_len)
+{
+  block_t t = S[0], u;
+  uint8_t i;
+
+  if (tag_len == AES_BLOCKLEN)
+  {
+    for (i = 1; i < n16; ++i)
+    {
+      t = XorBlocks(t, S[i]);
+    }
+    StoreBlock(tag, t);
+    return;
+  }
+  u = S[n32 / 2];
+  for (i = 1; i < n32 / 2; ++i)
+  {
+    t = XorBlocks(t, S[i]);
+    u = XorBlocks(u, S[n32 / 2 + i]);
+  }
+  StoreBlock(tag, t);
+  StoreBlock(tag + AES_BLOCKLEN, u);
+}
+
+static void Aegis128LUpdate(block_t* S, block_t M0, block_t M1)
+{
+  block_t t = S[7];
+
+  S[7] = RoundBlock(S[6], S[7]);
+  S[6] = RoundBlock(S[5], S[6]);
+  S[5] = RoundBlock(S[4], S[5]);
+  S[4] = RoundBlock(S[3], XorBlocks(S[4], M1));
+  S[3] = RoundBlock(S[2], S[3]);
+  S[2] = RoundBlock(S[1], S[2]);
+  S[1] = RoundBlock(S[0], S[1]);
+  S[0] = RoundBlock(t, XorBlocks(S[0], M0));
+}
+
+// The keystream of AEGIS-128L for the next 32 bytes, into z[0] and z[1]
+static void Aegis128LStream(const block_t* S, block_t* z)
+{
+  z[0] = XorBlocks(XorBlocks(S[6], S[1]), AndBlocks(S[2], S[3]));
+  z[1] = XorBlocks(XorBlocks(S[2], S[5]), AndBlocks(S[6], S[7]));
+}
+
+static void Aegis128LCrypt(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                           uint8_t* buf, size_t length, int encrypt, uint8_t* tag, size_t tag_len)
+{
+  block_t S[8], z[2], m[2], t;
+  uint8_t pad[2 * AES_BLOCKLEN];
+  block_t k = LoadBlock(key);
+  block_t n = LoadBlock(nonce);
+  block_t c0 = LoadBlock(AegisC0);
+  block_t c1 = LoadBlock(AegisC1);
+  size_t i, r;
+  uint8_t j;
+
+  S[0] = XorBlocks(k, n);
+  S[1] = c1;
+  S[2] = c0;
+  S[3] = c1;
+  S[4] = S[0];
+  S[5] = XorBlocks(k, c0);
+  S[6] = XorBlocks(k, c1);
+  S[7] = S[5];
+  for (j = 0; j < 10; ++j)
+  {
+    Aegis128LUpdate(S, n, k);
+  }
+
+  for (i = 0; i < aad_len; i += 2 * AES_BLOCKLEN)
+  {
+    r = aad_len - i;
+    if (r < 2 * AES_BLOCKLEN)
+    {
+      memset(pad, 0, sizeof(pad));
+      memcpy(pad, aad + i, r);
+      Aegis128LUpdate(S, LoadBlock(pad), LoadBlock(pad + AES_BLOCKLEN));
+    }
+    else
+    {
+      Aegis128LUpdate(S, LoadBlock(aad + i), LoadBlock(aad + i + AES_BLOCKLEN));
+    }
+  }
+
+  for (i = 0; i < length; i += 2 * AES_BLOCKLEN)
+  {
+    uint8_t* p = buf + i;
+
+    r = length - i;
+    if (r < 2 * AES_BLOCKLEN)
+    {
+      memset(pad, 0, sizeof(pad));
+      memcpy(pad, p, r);
+      p = pad;
+    }
+    Aegis128LStream(S, z);
+    m[0] = LoadBlock(p);
+    m[1] = LoadBlock(p + AES_BLOCKLEN);
+    StoreBlock(p, XorBlocks(m[0], z[0]));
+    StoreBlock(p + AES_BLOCKLEN, XorBlocks(m[1], z[1]));
+    if (!encrypt)
+    {
+      // The plaintext is absorbed, zero padded past the end of a partial block
+      if (p == pad)
+      {
+        memset(pad + r, 0, sizeof(pad) - r);
+      }
+      m[0] = LoadBlock(p);
+      m[1] = LoadBlock(p + AES_BLOCKLEN);
+    }
+    Aegis128LUpdate(S, m[0], m[1]);
+    if (p == pad)
+    {
+      memcpy(buf + i, pad, r);
+    }
+  }
+
+  t = XorBlocks(S[2], AegisLengths(aad_len, length));
+  for (j = 0; j < 7; ++j)
+  {
+    Aegis128LUpdate(S, t, t);
+  }
+  AegisTag(S, 7, 8, tag, tag_len);
+}
+
+static void Aegis256Update(block_t* S, block_t M)
+{
+  block_t t = S[5];
+
+  S[5] = RoundBlock(S[4], S[5]);
+  S[4] = RoundBlock(S[3], S[4]);
+  S[3] = RoundBlock(S[2], S[3]);
+  S[2] = RoundBlock(S[1], S[2]);
+  S[1] = RoundBlock(S[0], S[1]);
+  S[0] = RoundBlock(t, XorBlocks(S[0], M));
+}
+
+static void Aegis256Crypt(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                          uint8_t* buf, size_t length, int encrypt, uint8_t* tag, size_t tag_len)
+{
+  block_t S[6], z, m, t;
+  uint8_t pad[AES_BLOCKLEN];
+  block_t k0 = LoadBlock(key);
+  block_t k1 = LoadBlock(key + AES_BLOCKLEN);
+  block_t kn0 = XorBlocks(k0, LoadBlock(nonce));
+  block_t kn1 = XorBlocks(k1, LoadBlock(nonce + AES_BLOCKLEN));
+  block_t c0 = LoadBlock(AegisC0);
+  block_t c1 = LoadBlock(AegisC1);
+  size_t i, r;
+  uint8_t j;
+
+  S[0] = kn0;
+  S[1] = kn1;
+  S[2] = c1;
+  S[3] = c0;
+  S[4] = XorBlocks(k0, c0);
+  S[5] = XorBlocks(k1, c1);
+  for (j = 0; j < 4; ++j)
+  {
+    Aegis256Update(S, k0);
+    Aegis256Update(S, k1);
+    Aegis256Update(S, kn0);
+    Aegis256Update(S, kn1);
+  }
+
+  for (i = 0; i < aad_len; i += AES_BLOCKLEN)
+  {
+    r = aad_len - i;
+    if (r < AES_BLOCKLEN)
+    {
+      memset(pad, 0, sizeof(pad));
+      memcpy(pad, aad + i, r);
+      Aegis256Update(S, LoadBlock(pad));
+    }
+    else
+    {
+      Aegis256Update(S, LoadBlock(aad + i));
+    }
+  }
+
+  for (i = 0; i < length; i += AES_BLOCKLEN)
+  {
+    uint8_t* p = buf + i;
+
+    r = length - i;
+    if (r < AES_BLOCKLEN)
+    {
+      memset(pad, 0, sizeof(pad));
+      memcpy(pad, p, r);
+      p = pad;
+    }
+    z = XorBlocks(XorBlocks(XorBlocks(S[1], S[4]), S[5]), AndBlocks(S[2], S[3]));
+    m = LoadBlock(p);
+    StoreBlock(p, XorBlocks(m, z));
+    if (!encrypt)
+    {
+      if (p == pad)
+      {
+        memset(pad + r, 0, sizeof(pad) - r);
+      }
+      m = LoadBlock(p);
+    }
+    Aegis256Update(S, m);
+    if (p == pad)
+    {
+      memcpy(buf + i, pad, r);
+    }
+  }
+
+  t = XorBlocks(S[3], AegisLengths(aad_len, length));
+  for (j = 0; j < 7; ++j)
+  {
+    Aegis256Update(S, t);
+  }
+  AegisTag(S, 6, 6, tag, tag_len);
+}
+
+void AES_AEGIS128L_encrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                  uint8_t* buf, size_t length, uint8_t* tag, size_t tag_len)
+{
+  if (!AegisTagLenValid(tag_len))
+  {
+    return;
+  }
+  Aegis128LCrypt(key, nonce, aad, aad_len, buf, length, 1, tag, tag_len);
+}
+
+int AES_AEGIS128L_decrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                 uint8_t* buf, size_t length, const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[2 * AES_BLOCKLEN];
+
+  if (!AegisTagLenValid(tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  Aegis128LCrypt(key, nonce, aad, aad_len, buf, length, 0, full, tag_len);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+void AES_AEGIS256_encrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                 uint8_t* buf, size_t length, uint8_t* tag, size_t tag_len)
+{
+  if (!AegisTagLenValid(tag_len))
+  {
+    return;
+  }
+  Aegis256Crypt(key, nonce, aad, aad_len, buf, length, 1, tag, tag_len);
+}
+
+int AES_AEGIS256_decrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                uint8_t* buf, size_t length, const uint8_t* tag, size_t tag_len)
+{
+  uint8_t full[2 * AES_BLOCKLEN];
+
+  if (!AegisTagLenValid(tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  Aegis256Crypt(key, nonce, aad, aad_len, buf, length, 0, full, tag_len);
+  if (TagsDiffer(full, tag, tag_len))
+  {
+    memset(buf, 0, length);
+    return 1;
+  }
+  return 0;
+}
+
+#endif // #if defined(AEGIS) && (AEGIS == 1)
+
+
+#if defined(HARAKA) && (HARAKA == 1)
+
+// The round constants of Haraka v2, two AES rounds per block and round
+static const uint8_t HarakaRC[40][AES_BLOCKLEN] = {
+  { 0x9d, 0x7b, 0x81, 0x75, 0xf0, 0xfe, 0xc5, 0xb2, 0x0a, 0xc0, 0x20, 0xe6, 0x4c, 0x70, 0x84, 0x06 },
+  { 0x17, 0xf7, 0x08, 0x2f, 0xa4, 0x6b, 0x0f, 0x64, 0x6b, 0xa0, 0xf3, 0x88, 0xe1, 0xb4, 0x66, 0x8b },
+  { 0x14, 0x91, 0x02, 0x9f, 0x60, 0x9d, 0x02, 0xcf, 0x98, 0x84, 0xf2, 0x53, 0x2d, 0xde, 0x02, 0x34 },
+  { 0x79, 0x4f, 0x5b, 0xfd, 0xaf, 0xbc, 0xf3, 0xbb, 0x08, 0x4f, 0x7b, 0x2e, 0xe6, 0xea, 0xd6, 0x0e },
+  { 0x44, 0x70, 0x39, 0xbe, 0x1c, 0xcd, 0xee, 0x79, 0x8b, 0x44, 0x72, 0x48, 0xcb, 0xb0, 0xcf, 0xcb },
+  { 0x7b, 0x05, 0x8a, 0x2b, 0xed, 0x35, 0x53, 0x8d, 0xb7, 0x32, 0x90, 0x6e, 0xee, 0xcd, 0xea, 0x7e },
+  { 0x1b, 0xef, 0x4f, 0xda, 0x61, 0x27, 0x41, 0xe2, 0xd0, 0x7c, 0x2e, 0x5e, 0x43, 0x8f, 0xc2, 0x67 },
+  { 0x3b, 0x0b, 0xc7, 0x1f, 0xe2, 0xfd, 0x5f, 0x67, 0x07, 0xcc, 0xca, 0xaf, 0xb0, 0xd9, 0x24, 0x29 },
+  { 0xee, 0x65, 0xd4, 0xb9, 0xca, 0x8f, 0xdb, 0xec, 0xe9, 0x7f, 0x86, 0xe6, 0xf1, 0x63, 0x4d, 0xab },
+  { 0x33, 0x7e, 0x03, 0xad, 0x4f, 0x40, 0x2a, 0x5b, 0x64, 0xcd, 0xb7, 0xd4, 0x84, 0xbf, 0x30, 0x1c },
+  { 0x00, 0x98, 0xf6, 0x8d, 0x2e, 0x8b, 0x02, 0x69, 0xbf, 0x23, 0x17, 0x94, 0xb9, 0x0b, 0xcc, 0xb2 },
+  { 0x8a, 0x2d, 0x9d, 0x5c, 0xc8, 0x9e, 0xaa, 0x4a, 0x72, 0x55, 0x6f, 0xde, 0xa6, 0x78, 0x04, 0xfa },
+  { 0xd4, 0x9f, 0x12, 0x29, 0x2e, 0x4f, 0xfa, 0x0e, 0x12, 0x2a, 0x77, 0x6b, 0x2b, 0x9f, 0xb4, 0xdf },
+  { 0xee, 0x12, 0x6a, 0xbb, 0xae, 0x11, 0xd6, 0x32, 0x36, 0xa2, 0x49, 0xf4, 0x44, 0x03, 0xa1, 0x1e },
+  { 0xa6, 0xec, 0xa8, 0x9c, 0xc9, 0x00, 0x96, 0x5f, 0x84, 0x00, 0x05, 0x4b, 0x88, 0x49, 0x04, 0xaf },
+  { 0xec, 0x93, 0xe5, 0x27, 0xe3, 0xc7, 0xa2, 0x78, 0x4f, 0x9c, 0x19, 0x9d, 0xd8, 0x5e, 0x02, 0x21 },
+  { 0x73, 0x01, 0xd4, 0x82, 0xcd, 0x2e, 0x28, 0xb9, 0xb7, 0xc9, 0x59, 0xa7, 0xf8, 0xaa, 0x3a, 0xbf },
+  { 0x6b, 0x7d, 0x30, 0x10, 0xd9, 0xef, 0xf2, 0x37, 0x17, 0xb0, 0x86, 0x61, 0x0d, 0x70, 0x60, 0x62 },
+  { 0xc6, 0x9a, 0xfc, 0xf6, 0x53, 0x91, 0xc2, 0x81, 0x43, 0x04, 0x30, 0x21, 0xc2, 0x45, 0xca, 0x5a },
+  { 0x3a, 0x94, 0xd1, 0x36, 0xe8, 0x92, 0xaf, 0x2c, 0xbb, 0x68, 0x6b, 0x22, 0x3c, 0x97, 0x23, 0x92 },
+  { 0xb4, 0x71, 0x10, 0xe5, 0x58, 0xb9, 0xba, 0x6c, 0xeb, 0x86, 0x58, 0x22, 0x38, 0x92, 0xbf, 0xd3 },
+  { 0x8d, 0x12, 0xe1, 0x24, 0xdd, 0xfd, 0x3d, 0x93, 0x77, 0xc6, 0xf0, 0xae, 0xe5, 0x3c, 0x86, 0xdb },
+  { 0xb1, 0x12, 0x22, 0xcb, 0xe3, 0x8d, 0xe4, 0x83, 0x9c, 0xa0, 0xeb, 0xff, 0x68, 0x62, 0x60, 0xbb },
+  { 0x7d, 0xf7, 0x2b, 0xc7, 0x4e, 0x1a, 0xb9, 0x2d, 0x9c, 0xd1, 0xe4, 0xe2, 0xdc, 0xd3, 0x4b, 0x73 },
+  { 0x4e, 0x92, 0xb3, 0x2c, 0xc4, 0x15, 0x14, 0x4b, 0x43, 0x1b, 0x30, 0x61, 0xc3, 0x47, 0xbb, 0x43 },
+  { 0x99, 0x68, 0xeb, 0x16, 0xdd, 0x31, 0xb2, 0x03, 0xf6, 0xef, 0x07, 0xe7, 0xa8, 0x75, 0xa7, 0xdb },
+  { 0x2c, 0x47, 0xca, 0x7e, 0x02, 0x23, 0x5e, 0x8e, 0x77, 0x59, 0x75, 0x3c, 0x4b, 0x61, 0xf3, 0x6d },
+  { 0xf9, 0x17, 0x86, 0xb8, 0xb9, 0xe5, 0x1b, 0x6d, 0x77, 0x7d, 0xde, 0xd6, 0x17, 0x5a, 0xa7, 0xcd },
+  { 0x5d, 0xee, 0x46, 0xa9, 0x9d, 0x06, 0x6c, 0x9d, 0xaa, 0xe9, 0xa8, 0x6b, 0xf0, 0x43, 0x6b, 0xec },
+  { 0xc1, 0x27, 0xf3, 0x3b, 0x59, 0x11, 0x53, 0xa2, 0x2b, 0x33, 0x57, 0xf9, 0x50, 0x69, 0x1e, 0xcb },
+  { 0xd9, 0xd0, 0x0e, 0x60, 0x53, 0x03, 0xed, 0xe4, 0x9c, 0x61, 0xda, 0x00, 0x75, 0x0c, 0xee, 0x2c },
+  { 0x50, 0xa3, 0xa4, 0x63, 0xbc, 0xba, 0xbb, 0x80, 0xab, 0x0c, 0xe9, 0x96, 0xa1, 0xa5, 0xb1, 0xf0 },
+  { 0x39, 0xca, 0x8d, 0x93, 0x30, 0xde, 0x0d, 0xab, 0x88, 0x29, 0x96, 0x5e, 0x02, 0xb1, 0x3d, 0xae },
+  { 0x42, 0xb4, 0x75, 0x2e, 0xa8, 0xf3, 0x14, 0x88, 0x0b, 0xa4, 0x54, 0xd5, 0x38, 0x8f, 0xbb, 0x17 },
+  { 0xf6, 0x16, 0x0a, 0x36, 0x79, 0xb7, 0xb6, 0xae, 0xd7, 0x7f, 0x42, 0x5f, 0x5b, 0x8a, 0xbb, 0x34 },
+  { 0xde, 0xaf, 0xba, 0xff, 0x18, 0x59, 0xce, 0x43, 0x38, 0x54, 0xe5, 0xcb, 0x41, 0x52, 0xf6, 0x26 },
+  { 0x78, 0xc9, 0x9e, 0x83, 0xf7, 0x9c, 0xca, 0xa2, 0x6a, 0x02, 0xf3, 0xb9, 0x54, 0x9a, 0xe9, 0x4c },
+  { 0x35, 0x12, 0x90, 0x22, 0x28, 0x6e, 0xc0, 0x40, 0xbe, 0xf7, 0xdf, 0x1b, 0x1a, 0xa5, 0x51, 0xae },
+  { 0xcf, 0x59, 0xa6, 0x48, 0x0f, 0xbc, 0x73, 0xc1, 0x2b, 0xd2, 0x7e, 0xba, 0x3c, 0x61, 0xc1, 0xa0 },
+  { 0xa1, 0x9d, 0xc5, 0xe9, 0xfd, 0xbd, 0xd6, 0x4a, 0x88, 0x82, 0x28, 0x02, 0x03, 0xcc, 0x6a, 0x75 } };
+
+// Each of the 5 rounds is two AES rounds on every block, then a mix of their 32 bit words. The permutations
+// run n <= AES_LANES states round by round, one state at a time in locals. The states are independent, so the
+// CPU overlaps the AES rounds of one state with those of the next.
+static inline void Haraka256Perm(block_t (*s)[2], size_t n)
+{
+  const uint8_t (*rc)[AES_BLOCKLEN];
+  block_t s0, s1;
+  size_t l;
+  uint8_t r;
+
+  for (r = 0; r < 5; ++r)
+  {
+    rc = HarakaRC + 4 * r;
+    for (l = 0; l < n; ++l)
+    {
+      s0 = RoundBlock(s[l][0], LoadBlock(rc[0]));
+      s1 = RoundBlock(s[l][1], LoadBlock(rc[1]));
+      s0 = RoundBlock(s0, LoadBlock(rc[2]));
+      s1 = RoundBlock(s1, LoadBlock(rc[3]));
+      s[l][0] = UnpackLo(s0, s1);
+      s[l][1] = UnpackHi(s0, s1);
+    }
+  }
+}
+
+static inline void Haraka512Perm(block_t (*s)[4], size_t n)
+{
+  const uint8_t (*rc)[AES_BLOCKLEN];
+  block_t s0, s1, s2, s3, t;
+  size_t l;
+  uint8_t r;
+
+  for (r = 0; r < 5; ++r)
+  {
+    rc = HarakaRC + 8 * r;
+    for (l = 0; l < n; ++l)
+    {
+      s0 = RoundBlock(s[l][0], LoadBlock(rc[0]));
+      s1 = RoundBlock(s[l][1], LoadBlock(rc[1]));
+      s2 = RoundBlock(s[l][2], LoadBlock(rc[2]));
+      s3 = RoundBlock(s[l][3], LoadBlock(rc[3]));
+      s0 = RoundBlock(s0, LoadBlock(rc[4]));
+      s1 = RoundBlock(s1, LoadBlock(rc[5]));
+      s2 = RoundBlock(s2, LoadBlock(rc[6]));
+      s3 = RoundBlock(s3, LoadBlock(rc[7]));
+
+      t  = UnpackLo(s0, s1);
+      s0 = UnpackHi(s0, s1);
+      s1 = UnpackLo(s2, s3);
+      s2 = UnpackHi(s2, s3);
+      s[l][0] = UnpackHi(s0, s2);
+      s[l][1] = UnpackLo(s1, t);
+      s[l][2] = UnpackHi(s1, t);
+      s[l][3] = UnpackLo(s0, s2);
+    }
+  }
+}
+
+// Hashes n <= AES_LANES inputs. It is inlined with a constant n where it is called, so the lane loops unroll.
+static inline void Haraka256Lanes(const uint8_t* in, uint8_t* out, size_t n)
+{
+  block_t s[AES_LANES][2];
+  size_t l;
+  uint8_t i;
+
+  for (l = 0; l < n; ++l)
+  {
+    s[l][0] = LoadBlock(in + 32 * l);
+    s[l][1] = LoadBlock(in + 32 * l + AES_BLOCKLEN);
+  }
+  Haraka256Perm(s, n);
+
+  // The feed-forward of the input
+  for (l = 0; l < n; ++l)
+  {
+    for (i = 0; i < 2; ++i)
+    {
+      StoreBlock(out + 32 * l + AES_BLOCKLEN * i, XorBlocks(s[l][i], LoadBlock(in + 32 * l + AES_BLOCKLEN * i)));
+    }
+  }
+}
+
+static inline void Haraka512Lanes(const uint8_t* in, uint8_t* out, size_t n)
+{
+  block_t s[AES_LANES][4];
+  uint8_t b[AES_BLOCKLEN];
+  size_t l;
+  uint8_t i;
+
+  for (l = 0; l < n; ++l)
+  {
+    for (i = 0; i < 4; ++i)
+    {
+      s[l][i] = LoadBlock(in + 64 * l + AES_BLOCKLEN * i);
+    }
+  }
+  Haraka512Perm(s, n);
+
+  // The feed-forward of the input, truncated to the high halves of the first two blocks and the low of the others
+  for (l = 0; l < n; ++l)
+  {
+    for (i = 0; i < 4; ++i)
+    {
+      StoreBlock(b, XorBlocks(s[l][i], LoadBlock(in + 64 * l + AES_BLOCKLEN * i)));
+      memcpy(out + 32 * l + 8 * i, b + ((i < 2) ? 8 : 0), 8);
+    }
+  }
+}
+
+void AES_Haraka256_hashes(const uint8_t* in, uint8_t* out, size_t count)
+{
+  for (; count >= AES_LANES; count -= AES_LANES, in += AES_LANES * 32, out += AES_LANES * 32)
+  {
+    Haraka256Lanes(in, out, AES_LANES);
+  }
+  for (; count > 0; --count, in += 32, out += 32)
+  {
+    Haraka256Lanes(in, out, 1);
+  }
+}
+
+void AES_Haraka512_hashes(const uint8_t* in, uint8_t* out, size_t count)
+{
+  for (; count >= AES_LANES; count -= AES_LANES, in += AES_LANES * 64, out += AES_LANES * 32)
+  {
+    Haraka512Lanes(in, out, AES_LANES);
+  }
+  for (; count > 0; --count, in += 64, out += 32)
+  {
+    Haraka512Lanes(in, out, 1);
+  }
+}
+
+void AES_Haraka256_hash(const uint8_t* in, uint8_t* out)
+{
+  Haraka256Lanes(in, out, 1);
+}
+
+void AES_Haraka512_hash(const uint8_t* in, uint8_t* out)
+{
+  Haraka512Lanes(in, out, 1);
+}
+
+#endif // #if defined(HARAKA) && (HARAKA == 1)
+
+
+#if defined(CRHASH) && (CRHASH == 1)
+
+// Masks AES_LANES labels at a time with their tweaks, after s() for the circular hash, encrypts them
+// together and adds the masked labels back into the ciphertexts.
+static void CrHashes(const struct AES_ctx* ctx, const uint8_t* labels, const uint8_t* tweaks, uint8_t* out, size_t count, uint8_t circular)
+{
+  state_t s[AES_LANES];
+  uint8_t y[AES_LANES][AES_BLOCKLEN];
+  size_t i, n;
+  uint8_t j;
+
+  while (count > 0)
+  {
+    n = (count < AES_LANES) ? count : AES_LANES;
+    for (i = 0; i < n; ++i)
+    {
+      if (circular)
+      {
+        for (j = 0; j < AES_BLOCKLEN / 2; ++j)
+        {
+          y[i][j] = labels[j] ^ labels[j + AES_BLOCKLEN / 2];
+          y[i][j + AES_BLOCKLEN / 2] = labels[j];
+        }
+      }
+      else
+      {
+        memcpy(y[i], labels, AES_BLOCKLEN);
+      }
+      if (tweaks)
+      {
+        XorBlock(y[i], tweaks);
+        tweaks += AES_BLOCKLEN;
+      }
+      memcpy(&s[i], y[i], AES_BLOCKLEN);
+      labels += AES_BLOCKLEN;
+    }
+    CipherBlocks(s, n, ctx->RoundKey);
+    for (i = 0; i < n; ++i)
+    {
+      XorBlock(y[i], (const uint8_t*)&s[i]);
+      memcpy(out, y[i], AES_BLOCKLEN);
+      out += AES_BLOCKLEN;
+    }
+    count -= n;
+  }
+}
+
+void AES_CR_hashes(const struct AES_ctx* ctx, const uint8_t* labels, const uint8_t* tweaks, uint8_t* out, size_t count)
+{
+  CrHashes(ctx, labels, tweaks, out, count, 0);
+}
+
+void AES_CCR_hashes(const struct AES_ctx* ctx, const uint8_t* labels, const uint8_t* tweaks, uint8_t* out, size_t count)
+{
+  CrHashes(ctx, labels, tweaks, out, count, 1);
+}
+
+#endif // #if defined(CRHASH) && (CRHASH == 1)
+
+
+
+#if defined(HCTR2) && (HCTR2 == 1)
+
+void AES_HCTR2_init_ctx(struct AES_HCTR2_ctx* ctx, const uint8_t* key)
+{
+  state_t blocks[2];
+
+  AES_init_ctx(&ctx->aes, key);
+  memset(blocks, 0, sizeof(blocks));
+  ((uint8_t*)&blocks[1])[0] = 1;
+  CipherBlocks(blocks, 2, ctx->aes.RoundKey);
+  PolyvalInit(&ctx->H, (const uint8_t*)&blocks[0]);
+  memcpy(ctx->L, &blocks[1], AES_BLOCKLEN);
+}
+
+// Hashes the prefix shared by both hashes of a message: the block [2 * bits(T) + 2] if the part of the message
+// after its first block is a whole number of blocks, else [2 * bits(T) + 3], then the zero-padded tweak.
+static void Hctr2Tweak(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len, size_t length, uint64_t X[2])
+{
+  uint8_t block[AES_BLOCKLEN] = { 0 };
+  uint64_t n = (uint64_t)tweak_len * 16 + ((length % AES_BLOCKLEN == 0) ? 2 : 3);
+  uint8_t i;
+
+  for (i = 0; i < 8; ++i)
+  {
+    block[i] = (uint8_t)(n >> (8 * i));
+  }
+  X[0] = 0;
+  X[1] = 0;
+  PolyvalPadded(&ctx->H, X, block, AES_BLOCKLEN);
+  PolyvalPadded(&ctx->H, X, tweak, tweak_len);
+}
+
+// Continues the tweak hash T over data, padded with a 1 byte and zeros if it ends in a partial block,
+// and adds the result into block.
+static void Hctr2Hash(const ghashKey_t* H, const uint64_t T[2], const uint8_t* data, size_t length, uint8_t* block)
+{
+  uint8_t last[AES_BLOCKLEN] = { 0 };
+  uint64_t X[2];
+  size_t full = length - length % AES_BLOCKLEN;
+  uint8_t i;
+
+  X[0] = T[0];
+  X[1] = T[1];
+  PolyvalPadded(H, X, data, full);
+  if (full < length)
+  {
+    memcpy(last, data + full, length - full);
+    last[length - full] = 1;
+    PolyvalPadded(H, X, last, AES_BLOCKLEN);
+  }
+  PutBE64(last, X[0]);
+  PutBE64(last + 8, X[1]);
+  for (i = 0; i < AES_BLOCKLEN; ++i)
+  {
+    block[i] ^= last[AES_BLOCKLEN - 1 - i];
+  }
+}
+
+// XCTR: buf ^= E(S ^ [1]), E(S ^ [2]), ... with little-endian counters, AES_LANES keystream blocks per
+// CipherBlocks() call. The counter is xored into S rather than added, so there is no carry to propagate.
+static void Hctr2Xctr(const roundKey_t* RoundKey, const uint8_t* S, uint8_t* buf, size_t length)
+{
+  state_t stream[AES_LANES];
+  uint64_t c = 1;
+  size_t i, n, len;
+  uint8_t j;
+
+  while (length > 0)
+  {
+    for (n = 0; (n < AES_LANES) && (n * AES_BLOCKLEN < length); ++n, ++c)
+    {
+      memcpy(&stream[n], S, AES_BLOCKLEN);
+      for (j = 0; j < 8; ++j)
+      {
+        ((uint8_t*)&stream[n])[j] ^= (uint8_t)(c >> (8 * j));
+      }
+    }
+    CipherBlocks(stream, n, RoundKey);
+
+    len = (length < n * AES_BLOCKLEN) ? length : n * AES_BLOCKLEN;
+    for (i = 0; i < len; ++i)
+    {
+      buf[i] ^= ((const uint8_t*)stream)[i];
+    }
+    buf += len;
+    length -= len;
+  }
+}
+
+// Both directions hash the rest of the message into the first block, run that block through the cipher,
+// apply XCTR to the rest under S = MM ^ UU ^ L, and hash the result back into the first block.
+static void Hctr2Crypt(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len,
+                       uint8_t* buf, size_t length, uint8_t decrypt)
+{
+  uint64_t T[2];
+  uint8_t S[AES_BLOCKLEN];
+
+  if (length < AES_BLOCKLEN)
+  {
+    return;
+  }
+  Hctr2Tweak(ctx, tweak, tweak_len, length, T);
+  Hctr2Hash(&ctx->H, T, buf + AES_BLOCKLEN, length - AES_BLOCKLEN, buf);
+  memcpy(S, buf, AES_BLOCKLEN);
+  if (decrypt)
+  {
+    InvCipher((state_t*)buf, ctx->aes.RoundKey);
+  }
+  else
+  {
+    Cipher((state_t*)buf, ctx->aes.RoundKey);
+  }
+  XorBlock(S, buf);
+  XorBlock(S, ctx->L);
+  Hctr2Xctr(ctx->aes.RoundKey, S, buf + AES_BLOCKLEN, length - AES_BLOCKLEN);
+  Hctr2Hash(&ctx->H, T, buf + AES_BLOCKLEN, length - AES_BLOCKLEN, buf);
+}
+
+void AES_HCTR2_encrypt_buffer(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len,
+                              uint8_t* buf, size_t length)
+{
+  Hctr2Crypt(ctx, tweak, tweak_len, buf, length, 0);
+}
+
+void AES_HCTR2_decrypt_buffer(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len,
+                              uint8_t* buf, size_t length)
+{
+  Hctr2Crypt(ctx, tweak, tweak_len, buf, length, 1);
+}
 
+#endif // #if defined(HCTR2) && (HCTR2 == 1)
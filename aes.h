@@ -23,7 +23,27 @@
 //
 // CBC enables AES encryption in CBC-mode of operation.
 // CTR enables encryption in counter-mode.
-// ECB enables the basic ECB 16-byte block algorithm. All can be enabled simultaneously.
+// ECB enables the basic ECB 16-byte block algorithm.
+// GCM enables authenticated encryption in Galois/counter mode.
+// CCM enables authenticated encryption in counter with CBC-MAC mode.
+// OCB enables authenticated encryption in offset codebook mode (OCB3).
+// XTS enables the XTS-AES tweakable mode for storage encryption (IEEE 1619).
+// CFB enables encryption in cipher feedback mode, with 128 bit (CFB-128) and 8 bit (CFB-8) segments.
+// OFB enables encryption in output feedback mode.
+// CMAC enables the CMAC message authentication code (NIST SP 800-38B, RFC 4493).
+// GCM_SIV enables nonce misuse-resistant authenticated encryption in AES-GCM-SIV (RFC 8452).
+// SIV enables deterministic authenticated encryption in AES-SIV (RFC 5297).
+// KW enables AES key wrap, with and without padding (RFC 3394, RFC 5649).
+// EAX enables authenticated encryption in EAX mode.
+// DRBG enables the CTR_DRBG random bit generator (NIST SP 800-90A), with and without derivation function.
+// FPE enables format-preserving encryption FF1 and FF3-1 (NIST SP 800-38G).
+// MMO enables the AES-MMO hash function (Matyas-Meyer-Oseas on AES-128, as in Zigbee).
+// ROUNDS enables single AES round functions, as building blocks for permutations and hashes made of AES rounds.
+// AEGIS enables authenticated encryption in AEGIS-128L and AEGIS-256, made of AES rounds.
+// HARAKA enables the Haraka v2 short-input hash functions Haraka-256 and Haraka-512, made of AES rounds.
+// CRHASH enables the fixed-key correlation-robust hashes of garbled circuits and OT extension.
+// HCTR2 enables length-preserving wide-block encryption in HCTR2.
+// All can be enabled simultaneously.
 
 // The #ifndef-guard allows it to be configured before #include'ing or at compile time.
 #ifndef CBC
@@ -38,6 +58,138 @@
   #define CTR 1
 #endif
 
+#ifndef GCM
+  #define GCM 1
+#endif
+
+#ifndef CCM
+  #define CCM 1
+#endif
+
+#ifndef OCB
+  #define OCB 1
+#endif
+
+#ifndef XTS
+  #define XTS 1
+#endif
+
+#ifndef CFB
+  #define CFB 1
+#endif
+
+#ifndef OFB
+  #define OFB 1
+#endif
+
+#ifndef CMAC
+  #define CMAC 1
+#endif
+
+#ifndef GCM_SIV
+  #define GCM_SIV 1
+#endif
+
+#ifndef SIV
+  #define SIV 1
+#endif
+
+#ifndef KW
+  #define KW 1
+#endif
+
+#ifndef EAX
+  #define EAX 1
+#endif
+
+#ifndef DRBG
+  #define DRBG 1
+#endif
+
+#ifndef FPE
+  #define FPE 1
+#endif
+
+#ifndef MMO
+  #define MMO 1
+#endif
+
+#ifndef ROUNDS
+  #define ROUNDS 1
+#endif
+
+#ifndef AEGIS
+  #define AEGIS 1
+#endif
+
+#ifndef HARAKA
+  #define HARAKA 1
+#endif
+
+#ifndef CRHASH
+  #define CRHASH 1
+#endif
+
+#ifndef HCTR2
+  #define HCTR2 1
+#endif
+
+// The GHASH multiplier of GCM, also computing POLYVAL for GCM-SIV and HCTR2. One of:
+// GHASH_PCLMUL uses the carry-less multiply instruction. It is the default on x86-64 when the compiler targets it (-mpclmul).
+// GHASH_CONSTANT_TIME uses a portable bit-serial multiply. It is slow, but it has no secret-dependent table lookups.
+// Otherwise a portable 4-bit table per key is used (Shoup's method). It is fast and takes 256 bytes in the context,
+// which are reserved whichever multiplier is selected.
+#ifndef GHASH_PCLMUL
+  #if defined(__PCLMUL__) && defined(__x86_64__)
+    #define GHASH_PCLMUL 1
+  #else
+    #define GHASH_PCLMUL 0
+  #endif
+#endif
+
+#ifndef GHASH_CONSTANT_TIME
+  #define GHASH_CONSTANT_TIME 0
+#endif
+
+#if (GHASH_PCLMUL == 0) && (GHASH_CONSTANT_TIME == 0)
+  #define GHASH_TABLE 1
+#else
+  #define GHASH_TABLE 0
+#endif
+
+// GCM and GMAC accept tags of 12 to 16 bytes (NIST SP 800-38D, 5.2.1.2). GCM_SHORT_TAGS also accepts
+// 4 and 8 byte tags, which SP 800-38D only allows under the restrictions of its Appendix C.
+#ifndef GCM_SHORT_TAGS
+  #define GCM_SHORT_TAGS 0
+#endif
+
+// AES_ROUND_AESNI runs the single round functions, AEGIS and Haraka on the AES-NI instructions, instead of the portable round code.
+// It is the default on x86 when the compiler targets them (-maes).
+#ifndef AES_ROUND_AESNI
+  #if defined(__AES__) && (defined(__x86_64__) || defined(__i386__))
+    #define AES_ROUND_AESNI 1
+  #else
+    #define AES_ROUND_AESNI 0
+  #endif
+#endif
+
+// CTR_NONTEMPORAL makes AES_CTR_keystream_buffer() write with non-temporal stores (SSE2), which bypass the cache.
+// This pays off for outputs much larger than the last level cache that are not read back right away.
+// Only 16 byte aligned output is streamed, other buffers are written normally.
+#ifndef CTR_NONTEMPORAL
+  #define CTR_NONTEMPORAL 0
+#endif
+
+// DRBG_FORK_DETECT records the process id in every DRBG and refuses to generate in a forked child until it
+// is reseeded, so parent and child never return the same bytes. It needs getpid() and is the default on POSIX.
+#ifndef DRBG_FORK_DETECT
+  #if defined(__unix__) || defined(__APPLE__)
+    #define DRBG_FORK_DETECT 1
+  #else
+    #define DRBG_FORK_DETECT 0
+  #endif
+#endif
+
 
 #define AES128 1
 //#define AES192 1
@@ -65,13 +217,127 @@ typedef union
 struct AES_ctx
 {
   roundKey_t RoundKey[AES_keyExpSize];
-#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
+#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1)) || \
+    (defined(CFB) && (CFB == 1)) || (defined(OFB) && (OFB == 1))
   uint8_t Iv[AES_BLOCKLEN];
 #endif
+#if defined(CTR) && (CTR == 1)
+  uint8_t CtrLen; // number of trailing Iv bytes incremented as the counter
+#endif
+};
+
+#if (defined(GCM) && (GCM == 1)) || (defined(GCM_SIV) && (GCM_SIV == 1)) || (defined(HCTR2) && (HCTR2 == 1))
+// The hash subkey in the form the compiled-in multiplier uses. It has the same size whichever that is, so
+// code built with and without -mpclmul agrees on the layout of the contexts holding it.
+typedef union
+{
+  struct
+  {
+    uint64_t hi[16]; // multiples 0..15 of the hash subkey H, for the 4-bit tables
+    uint64_t lo[16];
+  } table;
+  uint64_t pow[4][2]; // hash subkey powers H^1..H^4, pre-shifted for the carry-less multipliers
+} ghashKey_t;
+#endif
+
+#if defined(GCM) && (GCM == 1)
+struct AES_GCM_ctx
+{
+  struct AES_ctx aes;
+  ghashKey_t H;
+};
+
+struct AES_GMAC_ctx
+{
+  const struct AES_GCM_ctx* key;
+  uint64_t X[2];                // GHASH accumulator
+  uint8_t mask[AES_BLOCKLEN];   // E(J0), masking the tag
+  uint8_t block[AES_BLOCKLEN];  // pending partial block
+  uint64_t length;              // bytes authenticated so far
+};
+#endif
+
+#if defined(OCB) && (OCB == 1)
+#define OCB_L_COUNT 16 // L_0..L_15 cover messages up to 1 MiB, longer ones derive the rest on the fly
+
+struct AES_OCB_ctx
+{
+  struct AES_ctx aes;
+  uint8_t Lstar[AES_BLOCKLEN];
+  uint8_t Ldollar[AES_BLOCKLEN];
+  uint8_t L[OCB_L_COUNT][AES_BLOCKLEN];
+};
+#endif
+
+#if defined(XTS) && (XTS == 1)
+struct AES_XTS_ctx
+{
+  struct AES_ctx data;  // Key1, encrypts the data
+  struct AES_ctx tweak; // Key2, encrypts the sector numbers
+};
+#endif
+
+#if (defined(CMAC) && (CMAC == 1)) || (defined(SIV) && (SIV == 1)) || (defined(EAX) && (EAX == 1))
+struct AES_CMAC_ctx
+{
+  struct AES_ctx aes;
+  uint8_t K1[AES_BLOCKLEN]; // subkey for a full last block
+  uint8_t K2[AES_BLOCKLEN]; // subkey for a padded last block
+};
+#endif
+
+#if defined(SIV) && (SIV == 1)
+struct AES_SIV_ctx
+{
+  struct AES_CMAC_ctx mac; // K1, for S2V
+  struct AES_ctx ctr;      // K2, for CTR
+  uint8_t Z[AES_BLOCKLEN]; // CMAC of the zero block, the starting value of S2V
+};
+#endif
+
+#if defined(EAX) && (EAX == 1)
+struct AES_EAX_ctx
+{
+  struct AES_CMAC_ctx mac;
+  uint8_t L[3][AES_BLOCKLEN]; // encryptions of the OMAC tweak blocks [0], [1] and [2]
+};
+#endif
+
+#if defined(HCTR2) && (HCTR2 == 1)
+struct AES_HCTR2_ctx
+{
+  struct AES_ctx aes;
+  ghashKey_t H;            // POLYVAL key E(0)
+  uint8_t L[AES_BLOCKLEN]; // E(1), masking the XCTR nonce
+};
+#endif
+
+#if defined(DRBG) && (DRBG == 1)
+#define AES_DRBG_SEEDLEN (AES_BLOCKLEN + AES_KEYLEN) // seed length in bytes: the entropy input without derivation function
+
+#ifndef AES_DRBG_RESEED_INTERVAL
+  #define AES_DRBG_RESEED_INTERVAL ((uint64_t)1 << 48) // generate requests between reseeds, at most 2^48
+#endif
+
+#ifndef AES_DRBG_MAX_REQUEST
+  #define AES_DRBG_MAX_REQUEST 65536 // bytes per generate request, at most 2^19 bits
+#endif
+
+struct AES_DRBG_ctx
+{
+  struct AES_ctx aes;      // Key
+  uint8_t V[AES_BLOCKLEN]; // V + 1, the next counter block
+  uint64_t reseed_counter;
+  uint8_t df;              // 1 if the derivation function is used
+#if DRBG_FORK_DETECT
+  long pid;                // process that last seeded the instance
+#endif
 };
+#endif
 
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
-#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
+#if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1)) || \
+    (defined(CFB) && (CFB == 1)) || (defined(OFB) && (OFB == 1))
 void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv);
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv);
 #endif
@@ -83,6 +349,11 @@ void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv);
 void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf);
 void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf);
 
+// buffer size MUST be a multiple of AES_BLOCKLEN; every block is processed independently.
+// Several blocks are kept in flight at once, which is faster than calling the functions above in a loop.
+void AES_ECB_encrypt_buffer(const struct AES_ctx* ctx, uint8_t* buf, size_t length);
+void AES_ECB_decrypt_buffer(const struct AES_ctx* ctx, uint8_t* buf, size_t length);
+
 #endif // #if defined(ECB) && (ECB == !)
 
 
@@ -94,6 +365,20 @@ void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf);
 void AES_CBC_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 
+// Whole messages of any length, each call is one message: set a fresh IV before the next one.
+// AES_CBC_PKCS7_encrypt_buffer() pads buf in place and returns the padded length, the next multiple of
+// AES_BLOCKLEN above length. buf must have room for it, i.e. for up to length + AES_BLOCKLEN bytes.
+// AES_CBC_PKCS7_decrypt_buffer() takes the padded length, and sets *out_len to the length of the message.
+// It returns 0 if length is a non-zero multiple of AES_BLOCKLEN and the padding is valid. Otherwise it returns 1
+// and buf is wiped with zeros.
+// The padding is checked in constant time, but CBC has no integrity: authenticate the ciphertext before decrypting it.
+// AES_CBC_CS3_*() use ciphertext stealing (CBC-CS3), the ciphertext is as long as the message, at least AES_BLOCKLEN bytes.
+// Shorter buffers are left unchanged.
+size_t AES_CBC_PKCS7_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+int AES_CBC_PKCS7_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length, size_t* out_len);
+void AES_CBC_CS3_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+void AES_CBC_CS3_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+
 #endif // #if defined(CBC) && (CBC == 1)
 
 
@@ -106,7 +391,400 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 //        no IV should ever be reused with the same key 
 void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
 
+// Writes length bytes of raw keystream to out, which is not read. Same output as AES_CTR_xcrypt_buffer() on a
+// zeroed buffer, at half the memory traffic, and the Iv is advanced the same way.
+// Useful as a fast fixed-key PRF or pseudorandom generator, e.g. for simulations and test data.
+void AES_CTR_keystream_buffer(struct AES_ctx* ctx, uint8_t* out, size_t length);
+
+// By default the whole Iv is incremented as one 128 bit big-endian counter.
+// GCM, RFC 3686 and SRTP only count in the low 32 or 64 bits and wrap around within that field,
+// leaving the nonce part of the Iv untouched. bits must be 32, 64 or 128, other values leave the width unchanged.
+// NOTES: the width is reset to 128 bits by AES_init_ctx() and AES_init_ctx_iv()
+#define AES_CTR_WIDTH_32  32
+#define AES_CTR_WIDTH_64  64
+#define AES_CTR_WIDTH_128 128
+void AES_ctx_set_counter_width(struct AES_ctx* ctx, unsigned bits);
+
 #endif // #if defined(CTR) && (CTR == 1)
 
 
+#if defined(GCM) && (GCM == 1)
+
+// Authenticated encryption with associated data (NIST SP 800-38D).
+// The IV can be any non-zero length, 12 bytes is recommended and fastest. aad is authenticated but not encrypted.
+// buf is encrypted/decrypted in place and can be any length. Tags can be truncated to tag_len bytes: 12 to 16,
+// or 4 and 8 with GCM_SHORT_TAGS. AES_GCM_encrypt_buffer() does nothing if iv_len or tag_len is not allowed.
+// AES_GCM_decrypt_buffer() returns 0 if the tag matches. Otherwise, or if iv_len or tag_len is not allowed,
+// it returns 1 and buf is wiped with zeros.
+// NOTES: no IV should ever be reused with the same key
+void AES_GCM_init_ctx(struct AES_GCM_ctx* ctx, const uint8_t* key);
+void AES_GCM_encrypt_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len);
+int AES_GCM_decrypt_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len);
+
+// GMAC, GCM authenticating aad only. Only GHASH runs over the data, the IV takes one block cipher call.
+// The streaming functions take the data in pieces of any length, key being an AES_GCM_init_ctx()'ed context
+// which must outlive ctx. AES_GMAC_final() outputs the tag, AES_GMAC_verify() returns 0 if it matches tag.
+// IV and tag lengths are limited as for GCM: with an empty IV or a tag_len that is not allowed, no tag is
+// written and AES_GMAC_verify() returns 1.
+// NOTES: no IV should ever be reused with the same key
+void AES_GMAC_buffer(const struct AES_GCM_ctx* ctx, const uint8_t* iv, size_t iv_len,
+                     const uint8_t* aad, size_t aad_len, uint8_t* tag, size_t tag_len);
+void AES_GMAC_init(struct AES_GMAC_ctx* ctx, const struct AES_GCM_ctx* key, const uint8_t* iv, size_t iv_len);
+void AES_GMAC_update(struct AES_GMAC_ctx* ctx, const uint8_t* data, size_t length);
+void AES_GMAC_final(struct AES_GMAC_ctx* ctx, uint8_t* tag, size_t tag_len);
+int AES_GMAC_verify(struct AES_GMAC_ctx* ctx, const uint8_t* tag, size_t tag_len);
+
+#endif // #if defined(GCM) && (GCM == 1)
+
+
+#if defined(CCM) && (CCM == 1)
+
+// Authenticated encryption with associated data (NIST SP 800-38C, RFC 3610), you need only AES_init_ctx.
+// nonce_len is 7 to 13 bytes, and the message length must fit in the remaining 15 - nonce_len bytes.
+// tag_len is 4, 6, 8, 10, 12, 14 or 16. Use tag_len 0 for encryption without authentication (CCM* of IEEE 802.15.4).
+// AES_CCM_decrypt_buffer() returns 0 if the tag matches. Otherwise it returns 1 and buf is wiped with zeros.
+// Other nonce, tag or message lengths are rejected: encryption does nothing, and decryption wipes buf and returns 1.
+// NOTES: no nonce should ever be reused with the same key
+void AES_CCM_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len);
+int AES_CCM_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len);
+
+#endif // #if defined(CCM) && (CCM == 1)
+
+
+#if defined(OCB) && (OCB == 1)
+
+// Authenticated encryption with associated data (RFC 7253). Every block is an independent cipher call,
+// so encryption and decryption both run on the multi-block cipher.
+// nonce_len is 1 to 15 bytes (12 recommended), tag_len is 1 to 16 bytes. Other lengths are rejected:
+// AES_OCB_encrypt_buffer() then does nothing.
+// AES_OCB_decrypt_buffer() returns 0 if the tag matches. Otherwise it returns 1 and buf is wiped with zeros.
+// NOTES: no nonce should ever be reused with the same key
+void AES_OCB_init_ctx(struct AES_OCB_ctx* ctx, const uint8_t* key);
+void AES_OCB_encrypt_buffer(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len);
+int AES_OCB_decrypt_buffer(const struct AES_OCB_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len);
+
+#endif // #if defined(OCB) && (OCB == 1)
+
+
+#if defined(XTS) && (XTS == 1)
+
+// key is 2 * AES_KEYLEN bytes: the data key followed by the tweak key.
+// Each data unit (sector) is encrypted in place under its 64 bit sector number, and the ciphertext has the
+// same length as the plaintext: any length of at least AES_BLOCKLEN bytes works, using ciphertext stealing.
+// Shorter data units are left unchanged.
+// The _sectors functions process nsectors consecutive data units of sector_size bytes each, numbered
+// from sector upwards. Their tweaks and blocks are computed several at a time.
+void AES_XTS_init_ctx(struct AES_XTS_ctx* ctx, const uint8_t* key);
+void AES_XTS_encrypt_buffer(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf, size_t length);
+void AES_XTS_decrypt_buffer(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf, size_t length);
+void AES_XTS_encrypt_sectors(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf,
+                             size_t sector_size, size_t nsectors);
+void AES_XTS_decrypt_sectors(const struct AES_XTS_ctx* ctx, uint64_t sector, uint8_t* buf,
+                             size_t sector_size, size_t nsectors);
+
+#endif // #if defined(XTS) && (XTS == 1)
+
+
+#if defined(CFB) && (CFB == 1)
+
+// buffer size can be any length, the Iv in ctx is updated so that consecutive calls continue the stream.
+// Only the last call of a message may pass a length that is not a multiple of AES_BLOCKLEN (CFB-128).
+// Decryption keeps several blocks in flight at once, as all the inputs to the cipher are known ciphertext.
+// The CFB8 functions feed back one byte at a time (NIST SP 800-38A CFB-8), they take one block cipher call per byte.
+// NOTES: you need to set IV in ctx via AES_init_ctx_iv() or AES_ctx_set_iv()
+//        no IV should ever be reused with the same key
+void AES_CFB_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+void AES_CFB_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+void AES_CFB8_encrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+void AES_CFB8_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+
+#endif // #if defined(CFB) && (CFB == 1)
+
+
+#if defined(OFB) && (OFB == 1)
+
+// Same function for encrypting as for decrypting.
+// buffer size can be any length, a partial last block ends the stream like in CTR mode.
+// NOTES: you need to set IV in ctx via AES_init_ctx_iv() or AES_ctx_set_iv()
+//        no IV should ever be reused with the same key
+void AES_OFB_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, size_t length);
+
+#endif // #if defined(OFB) && (OFB == 1)
+
+
+#if defined(CMAC) && (CMAC == 1)
+
+// AES_CMAC_init_ctx() expands the key and derives the subkeys K1 and K2 once.
+// AES_CMAC_buffer() writes the AES_BLOCKLEN byte MAC of msg to mac. It can be truncated by the caller.
+// AES_CMAC_buffers() computes the MACs of count independent messages msgs[i] of lengths[i] bytes into
+// macs + i * AES_BLOCKLEN. The chains of several messages are run side by side, which is much faster
+// than calling AES_CMAC_buffer() in a loop when the messages are short.
+void AES_CMAC_init_ctx(struct AES_CMAC_ctx* ctx, const uint8_t* key);
+void AES_CMAC_buffer(const struct AES_CMAC_ctx* ctx, const uint8_t* msg, size_t length, uint8_t* mac);
+void AES_CMAC_buffers(const struct AES_CMAC_ctx* ctx, const uint8_t* const* msgs, const size_t* lengths,
+                      size_t count, uint8_t* macs);
+
+// Key derivation in counter mode with CMAC as the PRF (NIST SP 800-108), ctx holding the key derivation key.
+// AES_CMAC_KDF_buffer() derives out_len bytes from label and context, with a 32 bit counter and length field.
+// AES_CMAC_KDF_buffers() derives count outputs of out_len bytes each into out + i * out_len, from labels[i]
+// and contexts[i]. The CMAC chains of all their blocks are run side by side as in AES_CMAC_buffers().
+void AES_CMAC_KDF_buffer(const struct AES_CMAC_ctx* ctx, const uint8_t* label, size_t label_len,
+                         const uint8_t* context, size_t context_len, uint8_t* out, size_t out_len);
+void AES_CMAC_KDF_buffers(const struct AES_CMAC_ctx* ctx, const uint8_t* const* labels, const size_t* label_lens,
+                          const uint8_t* const* contexts, const size_t* context_lens, size_t count,
+                          uint8_t* out, size_t out_len);
+
+#endif // #if defined(CMAC) && (CMAC == 1)
+
+
+#if defined(GCM_SIV) && (GCM_SIV == 1)
+
+// Authenticated encryption with associated data (RFC 8452), you need only AES_init_ctx with the key-generating key.
+// Message keys are derived from the key for every nonce, so repeating a nonce only reveals whether the same
+// message was encrypted twice. The nonce is 12 bytes and the tag is always AES_BLOCKLEN bytes.
+// RFC 8452 defines AES-128 and AES-256. With AES192 the same construction derives a 24 byte message key.
+// AES_GCM_SIV_decrypt_buffer() returns 0 if the tag matches. Otherwise it returns 1 and buf is wiped with zeros.
+void AES_GCM_SIV_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                uint8_t* buf, size_t length, uint8_t* tag);
+int AES_GCM_SIV_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                               uint8_t* buf, size_t length, const uint8_t* tag);
+
+#endif // #if defined(GCM_SIV) && (GCM_SIV == 1)
+
+
+#if defined(SIV) && (SIV == 1)
+
+// Deterministic authenticated encryption (RFC 5297): the same plaintext and aad always give the same ciphertext,
+// which allows equality lookups on encrypted values. key is 2 * AES_KEYLEN bytes: the MAC key followed by the CTR key.
+// The synthetic IV doubles as the tag and is always AES_BLOCKLEN bytes. aad is a single associated data string,
+// aad_len 0 means no associated data. Add a random nonce to aad for non-deterministic encryption.
+// AES_SIV_encrypt_buffers() encrypts count values bufs[i] of lengths[i] bytes in place under the same aad, writing
+// their tags to tags + i * AES_BLOCKLEN. The S2V and CTR chains of several values are run side by side.
+// AES_SIV_decrypt_buffer() returns 0 if the tag matches. Otherwise it returns 1 and buf is wiped with zeros.
+void AES_SIV_init_ctx(struct AES_SIV_ctx* ctx, const uint8_t* key);
+void AES_SIV_encrypt_buffer(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                            uint8_t* buf, size_t length, uint8_t* tag);
+int AES_SIV_decrypt_buffer(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                           uint8_t* buf, size_t length, const uint8_t* tag);
+void AES_SIV_encrypt_buffers(const struct AES_SIV_ctx* ctx, const uint8_t* aad, size_t aad_len,
+                             uint8_t* const* bufs, const size_t* lengths, size_t count, uint8_t* tags);
+
+#endif // #if defined(SIV) && (SIV == 1)
+
+
+#if defined(KW) && (KW == 1)
+
+// Key wrapping with the key-encryption key (KEK) in ctx, you need only AES_init_ctx.
+// AES_KW_wrap_buffer() wraps a key of length bytes, a multiple of 8 and at least 16, into length + 8 bytes at out.
+// AES_KWP_wrap_buffer() wraps a key of 1 to 2^32 - 1 bytes into the next multiple of 8 above length, plus 8 bytes.
+// The unwrap functions take the wrapped length and write length - 8 bytes to out, the key length of KWP being
+// returned in out_len. They return 0 if the key is intact. Otherwise they return 1 and out is wiped with zeros.
+// Wrapped lengths must be multiples of 8, at least 24 for KW and 16 for KWP: other lengths are rejected with 1
+// and out is not written. The wrap functions do nothing for key lengths they cannot wrap.
+// in and out may be the same buffer.
+// The rewrap functions unwrap count wrapped keys bufs[i] of lengths[i] bytes in place under old_kek and wrap
+// them again under new_kek, running the chains of several keys side by side. They return 0 if all keys were intact.
+// Otherwise they return 1, and the buffers of the keys that failed to unwrap are wiped with zeros.
+void AES_KW_wrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out);
+int AES_KW_unwrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out);
+void AES_KWP_wrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out);
+int AES_KWP_unwrap_buffer(const struct AES_ctx* ctx, const uint8_t* in, size_t length, uint8_t* out, size_t* out_len);
+int AES_KW_rewrap_buffers(const struct AES_ctx* old_kek, const struct AES_ctx* new_kek, uint8_t* const* bufs,
+                          const size_t* lengths, size_t count);
+int AES_KWP_rewrap_buffers(const struct AES_ctx* old_kek, const struct AES_ctx* new_kek, uint8_t* const* bufs,
+                           const size_t* lengths, size_t count);
+
+#endif // #if defined(KW) && (KW == 1)
+
+
+#if defined(EAX) && (EAX == 1)
+
+// Authenticated encryption with associated data in EAX mode. The nonce can be any length, aad is authenticated but not encrypted.
+// buf is encrypted/decrypted in place and can be any length. Tags can be truncated to tag_len bytes, 4 to 16:
+// AES_EAX_encrypt_buffer() does nothing with other tag lengths, and AES_EAX_decrypt_buffer() returns 1.
+// AES_EAX_decrypt_buffer() returns 0 if the tag matches. Otherwise it returns 1 and buf is wiped with zeros.
+// NOTES: no nonce should ever be reused with the same key
+void AES_EAX_init_ctx(struct AES_EAX_ctx* ctx, const uint8_t* key);
+void AES_EAX_encrypt_buffer(const struct AES_EAX_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                            const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                            uint8_t* tag, size_t tag_len);
+int AES_EAX_decrypt_buffer(const struct AES_EAX_ctx* ctx, const uint8_t* nonce, size_t nonce_len,
+                           const uint8_t* aad, size_t aad_len, uint8_t* buf, size_t length,
+                           const uint8_t* tag, size_t tag_len);
+
+#endif // #if defined(EAX) && (EAX == 1)
+
+
+#if defined(DRBG) && (DRBG == 1)
+
+// Deterministic random bit generator CTR_DRBG (NIST SP 800-90A) on the AES key size selected above.
+// The entropy input must come from a true entropy source, the nonce and personalization string are optional.
+// AES_DRBG_init_ctx() uses the derivation function and takes inputs of any length. The entropy input should hold
+// at least AES_KEYLEN bytes of entropy and the nonce half as much.
+// AES_DRBG_init_ctx_no_df() takes exactly AES_DRBG_SEEDLEN bytes of full entropy, and personalization strings and
+// additional inputs of at most AES_DRBG_SEEDLEN bytes. AES_DRBG_reseed() takes the same lengths as the init used.
+// AES_DRBG_init_ctx_no_df() and AES_DRBG_reseed() return 0 on success, and 1 if an input is too long for the
+// instance, which is then left unseeded (init) or unchanged (reseed). An unseeded instance generates nothing.
+// AES_DRBG_generate() returns 0 on success. It returns 1 without output if the additional input is too long, or
+// when the instance must be reseeded first:
+// after AES_DRBG_RESEED_INTERVAL requests, or in a child process after fork() when DRBG_FORK_DETECT is enabled.
+// Requests longer than AES_DRBG_MAX_REQUEST bytes are served as several requests, the additional input going to the first.
+// NOTES: there is no global state and no locking. Give each thread its own instance, seeded independently.
+void AES_DRBG_init_ctx(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, size_t entropy_len,
+                       const uint8_t* nonce, size_t nonce_len, const uint8_t* pers, size_t pers_len);
+int AES_DRBG_init_ctx_no_df(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, const uint8_t* pers, size_t pers_len);
+int AES_DRBG_reseed(struct AES_DRBG_ctx* ctx, const uint8_t* entropy, size_t entropy_len,
+                    const uint8_t* additional, size_t add_len);
+int AES_DRBG_generate(struct AES_DRBG_ctx* ctx, uint8_t* out, size_t length, const uint8_t* additional, size_t add_len);
+
+#endif // #if defined(DRBG) && (DRBG == 1)
+
+
+#if defined(FPE) && (FPE == 1)
+
+// Format-preserving encryption (NIST SP 800-38G). X is a numeral string of length digits, one digit per byte and
+// most significant first, each digit below radix. It is encrypted in place into a numeral string of the same length.
+// radix is 2 to 256, and radix^length must be at least 1000000.
+// FF1 takes a tweak of any length, and strings of up to AES_FPE_MAX_LEN digits. You need only AES_init_ctx.
+// FF3-1 takes a 7 byte tweak, and strings of up to 2 * floor(96 / log2(radix)) digits, e.g. 56 decimal digits.
+// Its context is set up with AES_FF3_init_ctx(), as FF3-1 runs AES under the byte-reversed key.
+// The _buffers functions process count strings X[i] of lengths[i] digits under the same tweak. Their Feistel rounds
+// are run in lockstep, so a round of several strings takes one multi-block cipher call.
+// All of them return 0 on success. They return 1 and leave the strings untouched if the radix, a length or the
+// FF3-1 tweak length is out of range, for the _buffers functions if any string is.
+#ifndef AES_FPE_MAX_LEN
+  #define AES_FPE_MAX_LEN 128
+#endif
+
+int AES_FF1_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length);
+int AES_FF1_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length);
+int AES_FF1_encrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count);
+int AES_FF1_decrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count);
+
+void AES_FF3_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
+int AES_FF3_encrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length);
+int AES_FF3_decrypt_buffer(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                           uint8_t* X, size_t length);
+int AES_FF3_encrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count);
+int AES_FF3_decrypt_buffers(const struct AES_ctx* ctx, const uint8_t* tweak, size_t tweak_len, unsigned radix,
+                            uint8_t* const* X, const size_t* lengths, size_t count);
+
+#endif // #if defined(FPE) && (FPE == 1)
+
+
+#if defined(MMO) && (MMO == 1)
+
+// AES-MMO hash (Zigbee specification, B.6): H_i = E(H_(i-1), M_i) ^ M_i under AES-128, whatever key size is
+// selected above, starting from H_0 = 0 and with the Zigbee padding. No context is needed.
+// AES_MMO_hash() writes the AES_BLOCKLEN byte digest of msg to digest.
+// AES_MMO_hashes() hashes count messages msgs[i] of lengths[i] bytes into digests + i * AES_BLOCKLEN.
+// Several messages are hashed side by side, so short messages go much faster than in a loop.
+// NOTES: messages must be shorter than 2^29 bytes.
+void AES_MMO_hash(const uint8_t* msg, size_t length, uint8_t* digest);
+void AES_MMO_hashes(const uint8_t* const* msgs, const size_t* lengths, size_t count, uint8_t* digests);
+
+#endif // #if defined(MMO) && (MMO == 1)
+
+
+#if defined(ROUNDS) && (ROUNDS == 1)
+
+// Single AES rounds on a 16 byte block, in place. They compute the same as the x86 instructions:
+// AES_encrypt_round()      AESENC     block = MixColumns(ShiftRows(SubBytes(block))) ^ round_key
+// AES_encrypt_last_round() AESENCLAST block = ShiftRows(SubBytes(block)) ^ round_key
+// AES_decrypt_round()      AESDEC     block = InvMixColumns(InvSubBytes(InvShiftRows(block))) ^ round_key
+// AES_decrypt_last_round() AESDECLAST block = InvSubBytes(InvShiftRows(block)) ^ round_key
+// AES_inv_mix_columns()    AESIMC     block = InvMixColumns(block), turning round keys into AES_decrypt_round() keys
+// With AES_ROUND_AESNI they are those instructions. Bytes are in the order of the AES state, as in the other functions.
+void AES_encrypt_round(uint8_t* block, const uint8_t* round_key);
+void AES_encrypt_last_round(uint8_t* block, const uint8_t* round_key);
+void AES_decrypt_round(uint8_t* block, const uint8_t* round_key);
+void AES_decrypt_last_round(uint8_t* block, const uint8_t* round_key);
+void AES_inv_mix_columns(uint8_t* block);
+
+#endif // #if defined(ROUNDS) && (ROUNDS == 1)
+
+
+#if defined(AEGIS) && (AEGIS == 1)
+
+// Authenticated encryption with associated data in AEGIS-128L and AEGIS-256 (draft-irtf-cfrg-aegis-aead).
+// They use their own key sizes, whatever AES key size is selected above, and need no context:
+// AEGIS-128L takes a 16 byte key and a 16 byte nonce, AEGIS-256 a 32 byte key and a 32 byte nonce.
+// aad is authenticated but not encrypted. buf is encrypted/decrypted in place and can be any length.
+// tag_len is 16 or 32: with other values the encrypt functions do nothing and the decrypt functions return 1.
+// The decrypt functions return 0 if the tag matches. Otherwise they return 1 and buf is wiped with zeros.
+// NOTES: no nonce should ever be reused with the same key
+void AES_AEGIS128L_encrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                  uint8_t* buf, size_t length, uint8_t* tag, size_t tag_len);
+int AES_AEGIS128L_decrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                 uint8_t* buf, size_t length, const uint8_t* tag, size_t tag_len);
+void AES_AEGIS256_encrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                 uint8_t* buf, size_t length, uint8_t* tag, size_t tag_len);
+int AES_AEGIS256_decrypt_buffer(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, size_t aad_len,
+                                uint8_t* buf, size_t length, const uint8_t* tag, size_t tag_len);
+
+#endif // #if defined(AEGIS) && (AEGIS == 1)
+
+
+#if defined(HARAKA) && (HARAKA == 1)
+
+// Haraka v2 (Koelbl, Lauridsen, Mendel, Rechberger), hashing fixed size inputs: 32 bytes with Haraka-256 and 64 bytes
+// with Haraka-512, into 32 byte digests. It is meant for short inputs in hash-based signatures, not as a general hash.
+// The _hashes functions hash count inputs stored back to back in in, into out + i * 32. Their AES rounds are
+// interleaved AES_LANES inputs at a time, which keeps the AES pipeline full.
+void AES_Haraka256_hash(const uint8_t* in, uint8_t* out);
+void AES_Haraka256_hashes(const uint8_t* in, uint8_t* out, size_t count);
+void AES_Haraka512_hash(const uint8_t* in, uint8_t* out);
+void AES_Haraka512_hashes(const uint8_t* in, uint8_t* out, size_t count);
+
+#endif // #if defined(HARAKA) && (HARAKA == 1)
+
+
+#if defined(CRHASH) && (CRHASH == 1)
+
+// Fixed-key hashes of 128 bit labels, with the key schedule of ctx expanded once by AES_init_ctx() (Guo, Katz, Wang, Yu).
+// AES_CR_hashes() computes the correlation-robust hash   out_i = E(x_i ^ t_i) ^ x_i ^ t_i
+// AES_CCR_hashes() computes the circular one             out_i = E(s(x_i) ^ t_i) ^ s(x_i) ^ t_i
+// with s(L || R) = (L ^ R) || L on the 8 byte halves, as needed with free-XOR garbling.
+// labels, tweaks and out hold count blocks back to back; tweaks may be NULL for t_i = 0, and out may be labels.
+// The blocks are independent, so they go through the cipher AES_LANES at a time.
+void AES_CR_hashes(const struct AES_ctx* ctx, const uint8_t* labels, const uint8_t* tweaks, uint8_t* out, size_t count);
+void AES_CCR_hashes(const struct AES_ctx* ctx, const uint8_t* labels, const uint8_t* tweaks, uint8_t* out, size_t count);
+
+#endif // #if defined(CRHASH) && (CRHASH == 1)
+
+
+#if defined(HCTR2) && (HCTR2 == 1)
+
+// HCTR2 (Crowley, Huckleberry, Biggers) is a tweakable wide-block cipher: the ciphertext is exactly as long as the
+// plaintext, and changing any bit of the plaintext or the tweak changes the whole ciphertext. It suits filenames
+// and small records that must keep their length. There is no tag, so it is deterministic for a given tweak and
+// does not detect tampering. The tweak may be any length, including 0. buf is encrypted in place.
+// NOTES: length must be at least AES_BLOCKLEN bytes, shorter buffers are left unchanged.
+void AES_HCTR2_init_ctx(struct AES_HCTR2_ctx* ctx, const uint8_t* key);
+void AES_HCTR2_encrypt_buffer(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len,
+                              uint8_t* buf, size_t length);
+void AES_HCTR2_decrypt_buffer(const struct AES_HCTR2_ctx* ctx, const uint8_t* tweak, size_t tweak_len,
+                              uint8_t* buf, size_t length);
+
+#endif // #if defined(HCTR2) && (HCTR2 == 1)
+
+
 #endif // _AES_H_
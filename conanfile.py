@@ -33,6 +33,63 @@ class TinyAesCConan(ConanFile):
 
         # enable encryption in counter-mode
         "CTR": [True, False],
+
+        # enable authenticated encryption in Galois/counter mode
+        "GCM": [True, False],
+
+        # enable authenticated encryption in counter with CBC-MAC mode
+        "CCM": [True, False],
+
+        # enable authenticated encryption in offset codebook mode (OCB3)
+        "OCB": [True, False],
+
+        # enable XTS-AES tweakable encryption for storage
+        "XTS": [True, False],
+
+        # enable encryption in cipher feedback mode (CFB-128 and CFB-8)
+        "CFB": [True, False],
+
+        # enable encryption in output feedback mode
+        "OFB": [True, False],
+
+        # enable the CMAC message authentication code
+        "CMAC": [True, False],
+
+        # enable nonce misuse-resistant authenticated encryption in AES-GCM-SIV
+        "GCM_SIV": [True, False],
+
+        # enable deterministic authenticated encryption in AES-SIV
+        "SIV": [True, False],
+
+        # enable AES key wrap with and without padding
+        "KW": [True, False],
+
+        # enable authenticated encryption in EAX mode
+        "EAX": [True, False],
+
+        # enable the CTR_DRBG random bit generator
+        "DRBG": [True, False],
+
+        # enable format-preserving encryption FF1 and FF3-1
+        "FPE": [True, False],
+
+        # enable the AES-MMO hash function
+        "MMO": [True, False],
+
+        # enable the single AES round functions
+        "ROUNDS": [True, False],
+
+        # enable authenticated encryption in AEGIS-128L and AEGIS-256
+        "AEGIS": [True, False],
+
+        # enable the Haraka v2 short-input hash functions
+        "HARAKA": [True, False],
+
+        # enable the fixed-key correlation-robust hashes for garbled circuits
+        "CRHASH": [True, False],
+
+        # enable length-preserving wide-block encryption in HCTR2
+        "HCTR2": [True, False],
     }
 
     options = _options_dict
@@ -43,7 +100,26 @@ class TinyAesCConan(ConanFile):
         "AES256": False,
         "CBC": True,
         "ECB": True,
-        "CTR": True
+        "CTR": True,
+        "GCM": True,
+        "CCM": True,
+        "OCB": True,
+        "XTS": True,
+        "CFB": True,
+        "OFB": True,
+        "CMAC": True,
+        "GCM_SIV": True,
+        "SIV": True,
+        "KW": True,
+        "EAX": True,
+        "DRBG": True,
+        "FPE": True,
+        "MMO": True,
+        "ROUNDS": True,
+        "AEGIS": True,
+        "HARAKA": True,
+        "CRHASH": True,
+        "HCTR2": True
     }
 
     def configure(self):
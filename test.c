@@ -16,8 +16,62 @@ static int test_encrypt_cbc(void);
 static int test_decrypt_cbc(void);
 static int test_encrypt_ctr(void);
 static int test_decrypt_ctr(void);
+static int test_xcrypt_ctr_width(void);
+static int test_xcrypt_ctr_width64(void);
 static int test_encrypt_ecb(void);
 static int test_decrypt_ecb(void);
+static int test_xcrypt_ecb_buffer(void);
+static int test_encrypt_gcm(void);
+static int test_decrypt_gcm(void);
+static int test_encrypt_ccm(void);
+static int test_decrypt_ccm(void);
+static int test_encrypt_ocb(void);
+static int test_decrypt_ocb(void);
+static int test_encrypt_xts(void);
+static int test_decrypt_xts(void);
+static int test_encrypt_cfb(void);
+static int test_decrypt_cfb(void);
+static int test_xcrypt_ofb(void);
+static int test_cmac(void);
+static int test_cmac_buffers(void);
+static int test_encrypt_gcm_siv(void);
+static int test_decrypt_gcm_siv(void);
+static int test_encrypt_siv(void);
+static int test_decrypt_siv(void);
+static int test_siv_buffers(void);
+static int test_kw(void);
+static int test_kwp(void);
+static int test_kw_rewrap(void);
+static int test_encrypt_eax(void);
+static int test_decrypt_eax(void);
+static int test_drbg(void);
+static int test_drbg_no_df(void);
+static int test_drbg_reseed(void);
+static int test_ctr_keystream(void);
+static int test_ff1(void);
+static int test_ff3(void);
+static int test_ff1_buffers(void);
+static int test_cbc_pkcs7(void);
+static int test_encrypt_cbc_cs3(void);
+static int test_decrypt_cbc_cs3(void);
+static int test_gmac(void);
+static int test_gmac_stream(void);
+static int test_cmac_kdf(void);
+static int test_cmac_kdf_buffers(void);
+static int test_mmo(void);
+static int test_mmo_hashes(void);
+static int test_rounds(void);
+static int test_encrypt_aegis128l(void);
+static int test_decrypt_aegis128l(void);
+static int test_encrypt_aegis256(void);
+static int test_decrypt_aegis256(void);
+static int test_haraka256(void);
+static int test_haraka512(void);
+static int test_haraka_hashes(void);
+static int test_cr_hashes(void);
+static int test_ccr_hashes(void);
+static int test_encrypt_hctr2(void);
+static int test_decrypt_hctr2(void);
 static void test_encrypt_ecb_verbose(void);
 
 
@@ -37,8 +91,60 @@ int main(void)
 #endif
 
     exit = test_encrypt_cbc() + test_decrypt_cbc() +
-	test_encrypt_ctr() + test_decrypt_ctr() +
-	test_decrypt_ecb() + test_encrypt_ecb();
+	test_encrypt_ctr() + test_decrypt_ctr() + test_xcrypt_ctr_width() + test_xcrypt_ctr_width64() +
+	test_decrypt_ecb() + test_encrypt_ecb() +
+	test_xcrypt_ecb_buffer() +
+	test_encrypt_gcm() +
+	test_decrypt_gcm() +
+	test_encrypt_ccm() +
+	test_decrypt_ccm() +
+	test_encrypt_ocb() +
+	test_decrypt_ocb() +
+	test_encrypt_xts() +
+	test_decrypt_xts() +
+	test_encrypt_cfb() +
+	test_decrypt_cfb() +
+	test_xcrypt_ofb() +
+	test_cmac() +
+	test_cmac_buffers() +
+	test_encrypt_gcm_siv() +
+	test_decrypt_gcm_siv() +
+	test_encrypt_siv() +
+	test_decrypt_siv() +
+	test_siv_buffers() +
+	test_kw() +
+	test_kwp() +
+	test_kw_rewrap() +
+	test_encrypt_eax() +
+	test_decrypt_eax() +
+	test_drbg() +
+	test_drbg_no_df() +
+	test_drbg_reseed() +
+	test_ctr_keystream() +
+	test_ff1() +
+	test_ff3() +
+	test_ff1_buffers() +
+	test_cbc_pkcs7() +
+	test_encrypt_cbc_cs3() +
+	test_decrypt_cbc_cs3() +
+	test_gmac() +
+	test_gmac_stream() +
+	test_cmac_kdf() +
+	test_cmac_kdf_buffers() +
+	test_mmo() +
+	test_mmo_hashes() +
+	test_rounds() +
+	test_encrypt_aegis128l() +
+	test_decrypt_aegis128l() +
+	test_encrypt_aegis256() +
+	test_decrypt_aegis256() +
+	test_haraka256() +
+	test_haraka512() +
+	test_haraka_hashes() +
+	test_cr_hashes() +
+	test_ccr_hashes() +
+	test_encrypt_hctr2() +
+	test_decrypt_hctr2();
     test_encrypt_ecb_verbose();
 
     return exit;
@@ -280,6 +386,91 @@ static int test_xcrypt_ctr(const char* xcrypt)
     }
 }
 
+static int test_xcrypt_ctr_width(void)
+{
+    // 32 bit counter starting two blocks before wrap-around: the nonce part of the IV must stay untouched
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t in[48] = { 0x17, 0xac, 0x89, 0xea, 0x66, 0x05, 0x9d, 0xaf, 0xe1, 0x58, 0x50, 0xcf, 0xb3, 0x4c, 0x83, 0xed,
+                       0xaa, 0xe5, 0xa5, 0x72, 0x16, 0x6c, 0xf2, 0xc6, 0x63, 0xef, 0xe8, 0xd4, 0x91, 0x5c, 0x54, 0x7a,
+                       0x92, 0x30, 0xd0, 0xe7, 0x13, 0xe3, 0x02, 0xe7, 0x4a, 0xae, 0x96, 0x44, 0x57, 0x9b, 0x04, 0x0b };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t in[48] = { 0xbf, 0x95, 0x7d, 0xfd, 0x0f, 0x97, 0x3a, 0xc5, 0x0d, 0x5a, 0x20, 0x04, 0x7b, 0x9e, 0xe1, 0x1f,
+                       0x92, 0xdf, 0x49, 0xf0, 0x1c, 0x73, 0xde, 0x9a, 0x6b, 0xe9, 0xbc, 0x58, 0x22, 0x73, 0xc0, 0xfd,
+                       0x94, 0x4f, 0xce, 0x80, 0xe8, 0x7e, 0x53, 0x8b, 0xde, 0x57, 0x21, 0x94, 0x88, 0x2d, 0x6f, 0x2e };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t in[48] = { 0x44, 0x9c, 0x73, 0x73, 0x03, 0x54, 0xb3, 0xab, 0xae, 0x24, 0x55, 0x50, 0xa2, 0x64, 0x34, 0x6f,
+                       0x92, 0xcc, 0xea, 0xd4, 0x7e, 0xdb, 0x97, 0x6f, 0xe6, 0x1d, 0x00, 0xac, 0x4a, 0xce, 0x0c, 0x93,
+                       0x79, 0xec, 0x8d, 0x15, 0xfa, 0xc4, 0x1e, 0x35, 0xfb, 0x00, 0x0a, 0x1a, 0x00, 0xb4, 0x54, 0x88 };
+#endif
+    uint8_t iv[16]  = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xff, 0xff, 0xff, 0xfe };
+    uint8_t out[48] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_ctx_set_counter_width(&ctx, AES_CTR_WIDTH_32);
+    AES_CTR_xcrypt_buffer(&ctx, in, 48);
+
+    printf("CTR 32 bit counter: ");
+
+    if (0 == memcmp((char *) out, (char *) in, 48)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_xcrypt_ctr_width64(void)
+{
+    // 64 bit counter starting two blocks before wrap-around, after an invalid width that must be ignored
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t in[48] = { 0x1d, 0x63, 0xfb, 0x58, 0x84, 0x81, 0x96, 0xe0, 0x41, 0x1d, 0xfa, 0x55, 0x85, 0x5a, 0x2b, 0x3f,
+                       0xba, 0xe1, 0xec, 0x05, 0xac, 0x95, 0x99, 0x27, 0xfe, 0xfd, 0x48, 0xc7, 0xc1, 0x94, 0x6b, 0xd0,
+                       0x84, 0x78, 0x2b, 0x09, 0x1c, 0x6a, 0x70, 0xd9, 0x94, 0x1a, 0x13, 0x89, 0xdf, 0xb0, 0x41, 0x48 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t in[48] = { 0xcb, 0x22, 0xde, 0x05, 0x44, 0xd9, 0x68, 0x05, 0x71, 0x44, 0xc9, 0x54, 0x15, 0x8b, 0x86, 0x8d,
+                       0x7a, 0xf8, 0xb8, 0x08, 0x3e, 0x83, 0xa9, 0x73, 0x42, 0x9b, 0xa7, 0xb0, 0xfa, 0xd4, 0x68, 0x1e,
+                       0x71, 0xb1, 0x1c, 0x42, 0x2f, 0xad, 0x3f, 0xa1, 0xc5, 0x0b, 0x55, 0xbc, 0x5b, 0xb9, 0xef, 0xec };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t in[48] = { 0x56, 0x86, 0xd7, 0x95, 0x6a, 0x24, 0xe7, 0xd4, 0x96, 0x87, 0x96, 0xd1, 0x66, 0xa1, 0x1c, 0x59,
+                       0xdf, 0x03, 0x1b, 0x44, 0x14, 0x0d, 0x6a, 0x44, 0x32, 0xca, 0xdd, 0x3b, 0x45, 0x4e, 0xa8, 0xc8,
+                       0x3c, 0xe7, 0xa7, 0xf0, 0xf9, 0x85, 0x83, 0x3b, 0xfc, 0x05, 0x3c, 0x2c, 0x81, 0xf9, 0x19, 0xed };
+#endif
+    uint8_t iv[16]  = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe };
+    uint8_t out[48] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_ctx_set_counter_width(&ctx, AES_CTR_WIDTH_64);
+    AES_ctx_set_counter_width(&ctx, 0);
+    AES_CTR_xcrypt_buffer(&ctx, in, 48);
+
+    printf("CTR 64 bit counter: ");
+
+    if (0 == memcmp((char *) out, (char *) in, 48)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
 
 static int test_decrypt_ecb(void)
 {
@@ -313,4 +504,2677 @@ static int test_decrypt_ecb(void)
     }
 }
 
+static int test_xcrypt_ecb_buffer(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t out[112] = { 0xf3, 0xee, 0xd1, 0xbd, 0xb5, 0xd2, 0xa0, 0x3c, 0x06, 0x4b, 0x5a, 0x7e, 0x3d, 0xb1, 0x81, 0xf8,
+                         0x59, 0x1c, 0xcb, 0x10, 0xd4, 0x10, 0xed, 0x26, 0xdc, 0x5b, 0xa7, 0x4a, 0x31, 0x36, 0x28, 0x70,
+                         0xb6, 0xed, 0x21, 0xb9, 0x9c, 0xa6, 0xf4, 0xf9, 0xf1, 0x53, 0xe7, 0xb1, 0xbe, 0xaf, 0xed, 0x1d,
+                         0x23, 0x30, 0x4b, 0x7a, 0x39, 0xf9, 0xf3, 0xff, 0x06, 0x7d, 0x8d, 0x8f, 0x9e, 0x24, 0xec, 0xc7,
+                         0xf3, 0xee, 0xd1, 0xbd, 0xb5, 0xd2, 0xa0, 0x3c, 0x06, 0x4b, 0x5a, 0x7e, 0x3d, 0xb1, 0x81, 0xf8,
+                         0x59, 0x1c, 0xcb, 0x10, 0xd4, 0x10, 0xed, 0x26, 0xdc, 0x5b, 0xa7, 0x4a, 0x31, 0x36, 0x28, 0x70,
+                         0xb6, 0xed, 0x21, 0xb9, 0x9c, 0xa6, 0xf4, 0xf9, 0xf1, 0x53, 0xe7, 0xb1, 0xbe, 0xaf, 0xed, 0x1d };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t out[112] = { 0xbd, 0x33, 0x4f, 0x1d, 0x6e, 0x45, 0xf2, 0x5f, 0xf7, 0x12, 0xa2, 0x14, 0x57, 0x1f, 0xa5, 0xcc,
+                         0x97, 0x41, 0x04, 0x84, 0x6d, 0x0a, 0xd3, 0xad, 0x77, 0x34, 0xec, 0xb3, 0xec, 0xee, 0x4e, 0xef,
+                         0xef, 0x7a, 0xfd, 0x22, 0x70, 0xe2, 0xe6, 0x0a, 0xdc, 0xe0, 0xba, 0x2f, 0xac, 0xe6, 0x44, 0x4e,
+                         0x9a, 0x4b, 0x41, 0xba, 0x73, 0x8d, 0x6c, 0x72, 0xfb, 0x16, 0x69, 0x16, 0x03, 0xc1, 0x8e, 0x0e,
+                         0xbd, 0x33, 0x4f, 0x1d, 0x6e, 0x45, 0xf2, 0x5f, 0xf7, 0x12, 0xa2, 0x14, 0x57, 0x1f, 0xa5, 0xcc,
+                         0x97, 0x41, 0x04, 0x84, 0x6d, 0x0a, 0xd3, 0xad, 0x77, 0x34, 0xec, 0xb3, 0xec, 0xee, 0x4e, 0xef,
+                         0xef, 0x7a, 0xfd, 0x22, 0x70, 0xe2, 0xe6, 0x0a, 0xdc, 0xe0, 0xba, 0x2f, 0xac, 0xe6, 0x44, 0x4e };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t out[112] = { 0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+                         0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+                         0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+                         0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4,
+                         0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+                         0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+                         0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88 };
+#endif
+
+    // Seven blocks, so a partial lane group follows the full one: the four SP 800-38A blocks, then the first three again
+    uint8_t in[112] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+                        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef };
+    uint8_t buf[112];
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+    memcpy(buf, in, 112);
+    AES_ECB_encrypt_buffer(&ctx, buf, 112);
+
+    printf("ECB encrypt buffer: ");
+
+    if (0 != memcmp((char*) out, (char*) buf, 112)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    printf("SUCCESS!\n");
+
+    AES_ECB_decrypt_buffer(&ctx, buf, 112);
+
+    printf("ECB decrypt buffer: ");
+
+    if (0 == memcmp((char*) in, (char*) buf, 112)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_gcm(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xcc, 0xe6, 0x56, 0x92, 0xc1, 0x06, 0x4e, 0xed, 0x7f, 0xa3, 0x04, 0x6a, 0xa4, 0x6b, 0xd8, 0xea,
+                       0xa9, 0xc7, 0xaa, 0x99, 0x0b, 0x4f, 0x96, 0x8b, 0xae, 0x83, 0xca, 0xe7, 0x28, 0xc0, 0x4f, 0x8c,
+                       0x05, 0xa1, 0x8f, 0x4f, 0x2d, 0xd6, 0xe1, 0x17, 0xa6, 0xc0, 0xb8, 0x48, 0x2a, 0xce, 0x7c, 0x73,
+                       0xfc, 0xd0, 0xf1, 0xae, 0x22, 0x8f, 0xa6, 0xab, 0x40, 0xdd, 0xf7, 0x86 };
+    uint8_t tag[16] = { 0x10, 0xa6, 0x62, 0xdc, 0xfb, 0x29, 0x1f, 0xea, 0xdb, 0x45, 0xd7, 0x22, 0x65, 0x98, 0xf3, 0xdb };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0xd9, 0xf2, 0x9c, 0x21, 0x2e, 0x0a, 0xe2, 0x9f, 0xa8, 0xab, 0xcc, 0x92, 0x65, 0xcb, 0x3d, 0x8b,
+                       0x46, 0xe5, 0x72, 0x8d, 0xa4, 0x66, 0x32, 0x69, 0x86, 0x36, 0x61, 0x3e, 0x0e, 0xfa, 0x1b, 0x19,
+                       0x58, 0xdc, 0xcd, 0x55, 0x49, 0x3f, 0xc8, 0x2a, 0x37, 0x51, 0xdb, 0xa6, 0xf9, 0xa9, 0x73, 0x68,
+                       0x98, 0x83, 0x35, 0xf5, 0xc3, 0x10, 0x00, 0x34, 0x15, 0xc3, 0xd8, 0x6b };
+    uint8_t tag[16] = { 0x8c, 0xe5, 0x02, 0x52, 0x88, 0xf4, 0x70, 0xa6, 0x3b, 0x57, 0x52, 0x75, 0xea, 0xbc, 0xa7, 0xa0 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x6a, 0xc7, 0xd9, 0xf7, 0x7a, 0x1c, 0x8a, 0x43, 0xaf, 0x5b, 0xe6, 0x37, 0x3b, 0x9f, 0x65, 0x62,
+                       0x81, 0xad, 0xe2, 0xf9, 0x1a, 0xe5, 0xae, 0x42, 0x86, 0x56, 0xa3, 0xe0, 0xbf, 0x5d, 0xde, 0x1e,
+                       0x69, 0xdb, 0xb5, 0xa6, 0x1f, 0x1c, 0x5d, 0x69, 0xde, 0xcf, 0x7c, 0x80, 0xc9, 0x46, 0x19, 0x34,
+                       0x35, 0xd0, 0xf3, 0x4a, 0xc5, 0xc4, 0xbf, 0xfa, 0x35, 0xa2, 0x58, 0x7e };
+    uint8_t tag[16] = { 0x4f, 0x85, 0xa5, 0x0f, 0x64, 0xf5, 0x4e, 0xf9, 0x10, 0x22, 0x65, 0xc2, 0x51, 0xce, 0x6f, 0x5f };
+#endif
+    uint8_t iv[12]  = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_GCM_ctx ctx;
+
+    AES_GCM_init_ctx(&ctx, key);
+    AES_GCM_encrypt_buffer(&ctx, iv, 12, aad, 20, in, 60, out_tag, 16);
+
+    printf("GCM encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_gcm(void)
+{
+    // 64 bit IV, which goes through GHASH to form the initial counter
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x60, 0x59, 0xae, 0x76, 0x59, 0xf5, 0x15, 0xb2, 0xa9, 0xdf, 0x83, 0x5f, 0x16, 0xb9, 0xa4, 0xf6,
+                       0xf0, 0xfe, 0xcc, 0x23, 0x8a, 0x63, 0xc4, 0x76, 0x85, 0xf4, 0x6d, 0x00, 0x1b, 0x6c, 0x2b, 0xd6,
+                       0xd2, 0x31, 0x53, 0x45, 0xc1, 0x2d, 0x79, 0x56, 0x2c, 0x89, 0x62, 0x45, 0x7d, 0xee, 0xcd, 0x25,
+                       0x74, 0x9b, 0xc1, 0x0b, 0x60, 0x60, 0xaf, 0xcb, 0xd5, 0xb2, 0x27, 0x9e };
+    uint8_t tag[16] = { 0x03, 0xe1, 0xce, 0x6d, 0xbf, 0xa0, 0xdf, 0x46, 0xfe, 0xf1, 0xb5, 0xd1, 0xe9, 0x01, 0x1d, 0xa7 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x47, 0x90, 0x25, 0x27, 0x9d, 0x3c, 0x1d, 0xa2, 0x45, 0x84, 0x5e, 0x44, 0x2b, 0x6d, 0xa8, 0xab,
+                       0x96, 0xd9, 0x99, 0xed, 0xbb, 0x9c, 0xcb, 0x81, 0x42, 0xd9, 0x7a, 0x32, 0xdf, 0xfd, 0x30, 0x24,
+                       0xb0, 0x31, 0x52, 0x9b, 0x17, 0x46, 0xa6, 0x29, 0x5b, 0xce, 0x03, 0x72, 0x25, 0x2c, 0x01, 0xd0,
+                       0x30, 0x04, 0x08, 0x71, 0xd4, 0x86, 0x73, 0xc5, 0x82, 0x78, 0xde, 0x62 };
+    uint8_t tag[16] = { 0xee, 0x56, 0xe8, 0xd6, 0x3c, 0x67, 0xd9, 0xf9, 0xcd, 0x98, 0x5f, 0x1a, 0xd2, 0x37, 0xb4, 0x7a };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0xa9, 0xce, 0x8b, 0xdb, 0xe9, 0xe9, 0x11, 0x7a, 0xfe, 0xbe, 0xc8, 0xb3, 0xd2, 0x51, 0x4f, 0x99,
+                       0xdb, 0xb2, 0x74, 0x1b, 0xe6, 0xd0, 0xdb, 0xa1, 0x17, 0x76, 0x7e, 0xfd, 0x34, 0x56, 0x39, 0x07,
+                       0x9d, 0x36, 0xf6, 0xb0, 0x7a, 0xdb, 0xe8, 0x8d, 0xc1, 0x94, 0xa3, 0x3a, 0x41, 0xe5, 0x2f, 0x38,
+                       0x86, 0x17, 0x0e, 0x06, 0x76, 0xac, 0xb1, 0xd7, 0x35, 0x58, 0xd2, 0xe9 };
+    uint8_t tag[16] = { 0x30, 0x5a, 0xfc, 0x42, 0x96, 0xda, 0x4d, 0xf6, 0x7d, 0xce, 0x4b, 0x44, 0x98, 0xf8, 0x24, 0xaf };
+#endif
+    uint8_t iv[8]   = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t in[60];
+    struct AES_GCM_ctx ctx;
+
+    AES_GCM_init_ctx(&ctx, key);
+
+    printf("GCM decrypt: ");
+
+    // a modified tag must be rejected
+    memcpy(in, ct, 60);
+    tag[15] ^= 0x01;
+    if (0 == AES_GCM_decrypt_buffer(&ctx, iv, 8, aad, 20, in, 60, tag, 16)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    tag[15] ^= 0x01;
+
+    // so must an empty tag, an over-long tag and an empty IV
+    memcpy(in, ct, 60);
+    if ((0 == AES_GCM_decrypt_buffer(&ctx, iv, 8, aad, 20, in, 60, tag, 0)) ||
+        (0 == AES_GCM_decrypt_buffer(&ctx, iv, 8, aad, 20, in, 60, tag, 17)) ||
+        (0 == AES_GCM_decrypt_buffer(&ctx, iv, 0, aad, 20, in, 60, tag, 16))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    memcpy(in, ct, 60);
+    if ((0 == AES_GCM_decrypt_buffer(&ctx, iv, 8, aad, 20, in, 60, tag, 16)) && (0 == memcmp((char*) out, (char*) in, 60))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_ccm(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x19, 0xae, 0xb7, 0x30, 0xce, 0x5c, 0x2c, 0xb8, 0x7d, 0x7d, 0x92, 0xe7, 0xb2, 0xfa, 0xab, 0x3d,
+                       0x86, 0x68, 0xd9, 0xd7, 0xa7, 0xac, 0x51, 0x13, 0x89, 0x49, 0x37, 0xac, 0x83, 0xe5, 0x14, 0xa5,
+                       0x20, 0xad, 0x04, 0x7a, 0xf5, 0x0f, 0xcf, 0x91, 0xa7, 0x6d, 0xf6, 0x9c, 0xd4, 0x95, 0x44, 0x54,
+                       0xf2, 0x4c, 0x4e, 0x96, 0x3c, 0x9f, 0xf1, 0x21, 0x9b, 0x6f, 0x0d, 0x21 };
+    uint8_t tag[16] = { 0xa9, 0x86, 0x73, 0xf5, 0x75, 0x86, 0x77, 0xfd, 0xc1, 0xd9, 0xa3, 0x75, 0x9f, 0xf2, 0x50, 0xe3 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x1e, 0x2b, 0xd6, 0x5b, 0x40, 0x9b, 0x5a, 0x3f, 0x04, 0xe9, 0xd0, 0x67, 0xff, 0x1c, 0xb9, 0x7d,
+                       0x8c, 0x70, 0xc4, 0x45, 0x53, 0xd7, 0xe4, 0xc5, 0xe5, 0x72, 0x13, 0xd1, 0xf1, 0xa8, 0x5b, 0x18,
+                       0x79, 0x61, 0xff, 0xc5, 0x1f, 0xdd, 0x0a, 0x9d, 0xd7, 0xc9, 0xaf, 0xb4, 0x42, 0x66, 0x3e, 0x5a,
+                       0x49, 0xfd, 0xf6, 0x83, 0xeb, 0x4b, 0x2e, 0xa9, 0x3e, 0xa3, 0x92, 0xd0 };
+    uint8_t tag[16] = { 0x13, 0x2b, 0x69, 0x05, 0x4a, 0x94, 0xdb, 0x22, 0xc3, 0xe5, 0x34, 0x82, 0x60, 0xc5, 0x7c, 0x09 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0xe2, 0x40, 0xa7, 0x0e, 0x5e, 0x40, 0x82, 0xb0, 0xf3, 0x8c, 0xfe, 0x73, 0x89, 0xca, 0x01, 0x39,
+                       0x2b, 0x97, 0x42, 0xa8, 0xe1, 0x94, 0xb6, 0x28, 0xd4, 0x9b, 0x68, 0x51, 0x01, 0xdf, 0xd6, 0x7b,
+                       0x5e, 0x92, 0x35, 0xeb, 0x81, 0x9a, 0x8c, 0x5d, 0xd1, 0x98, 0x70, 0xe3, 0x61, 0x44, 0x91, 0x19,
+                       0x59, 0x9d, 0x96, 0x12, 0x72, 0x01, 0x6f, 0x00, 0x57, 0x4a, 0x8e, 0x46 };
+    uint8_t tag[16] = { 0x9c, 0x50, 0x4a, 0x5e, 0xb5, 0xdc, 0xab, 0x19, 0x8c, 0xe4, 0xe3, 0x7b, 0x8b, 0x1f, 0xa7, 0x4c };
+#endif
+    uint8_t nonce[13] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0x00 };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+    AES_CCM_encrypt_buffer(&ctx, nonce, 13, aad, 20, in, 60, out_tag, 16);
+
+    printf("CCM encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_ccm(void)
+{
+    // 7 byte nonce (8 byte length field) and truncated 8 byte tag
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xbd, 0xfa, 0x98, 0x44, 0xb0, 0x3f, 0xf0, 0xba, 0xbd, 0xc5, 0xbf, 0xe3, 0xc1, 0xba, 0xc9, 0x5c,
+                       0x4c, 0x2c, 0x8d, 0xbf, 0x64, 0xea, 0xff, 0x4f, 0x6d, 0xff, 0x77, 0xbb, 0x8e, 0x04, 0x4a, 0x69,
+                       0x3d, 0x5b, 0x46, 0xe2, 0xf9, 0xdf, 0x3c, 0x4d, 0xa2, 0x8d, 0xa8, 0x95, 0xcc, 0xa2, 0xac, 0xe7,
+                       0x7b, 0x6f, 0x03, 0x91, 0xa4, 0x51, 0x7f, 0x44, 0xaa, 0xf2, 0x65, 0x9e };
+    uint8_t tag[8] = { 0xf1, 0x6e, 0x3c, 0x2f, 0xaf, 0x5f, 0x1d, 0x8a };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0xc4, 0xc0, 0x03, 0x5e, 0x42, 0xaa, 0x2e, 0x62, 0x82, 0xac, 0xb3, 0x39, 0xe3, 0xb0, 0x12, 0x07,
+                       0x11, 0xba, 0xec, 0x03, 0x2b, 0x31, 0x9f, 0x2c, 0xce, 0x30, 0x28, 0x57, 0xfb, 0x77, 0x32, 0xa7,
+                       0xf5, 0x24, 0xec, 0xea, 0xd0, 0xfd, 0xc9, 0x53, 0x7e, 0xad, 0xf5, 0xb5, 0x0c, 0xc8, 0x55, 0xb8,
+                       0x01, 0xdf, 0xc9, 0x68, 0x3c, 0xd5, 0x14, 0x1e, 0xf8, 0xee, 0xa2, 0x43 };
+    uint8_t tag[8] = { 0x03, 0x25, 0xe1, 0xeb, 0x54, 0x02, 0x83, 0xbb };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x34, 0x00, 0x33, 0xa7, 0x5e, 0x94, 0x70, 0x75, 0x80, 0x5d, 0x8b, 0xa1, 0x9a, 0xc9, 0x82, 0xd3,
+                       0xfb, 0x25, 0x59, 0xf9, 0xb8, 0x86, 0x20, 0x45, 0x67, 0xa7, 0x9c, 0xdc, 0x3f, 0x7c, 0x98, 0x2a,
+                       0xd3, 0xd2, 0x05, 0x2c, 0xae, 0x66, 0xa6, 0x3f, 0xd1, 0x11, 0x74, 0xcc, 0x93, 0xd3, 0x39, 0x81,
+                       0x4e, 0xd3, 0x45, 0xf1, 0x99, 0xad, 0x3c, 0xc9, 0xc7, 0xcd, 0x93, 0xa7 };
+    uint8_t tag[8] = { 0x51, 0x2b, 0x99, 0x0c, 0x5d, 0x5c, 0xde, 0x30 };
+#endif
+    uint8_t nonce[7] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t in[60];
+    static uint8_t big[0x10000]; // one byte more than a 13 byte nonce leaves room for
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+
+    printf("CCM decrypt: ");
+
+    // a modified tag must be rejected
+    memcpy(in, ct, 60);
+    tag[7] ^= 0x01;
+    if (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 8)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    tag[7] ^= 0x01;
+
+    // so must nonces outside 7..13, tags that are odd, 2 or above 16 bytes, and messages too long for L = 15 - nonce_len
+    memcpy(in, ct, 60);
+    if ((0 == AES_CCM_decrypt_buffer(&ctx, nonce, 6, aad, 20, in, 60, tag, 8)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 14, aad, 20, in, 60, tag, 8)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 15, aad, 20, in, 60, tag, 8)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 2)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 7)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 18)) ||
+        (0 == AES_CCM_decrypt_buffer(&ctx, nonce, 13, aad, 20, big, sizeof(big), tag, 8))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    memcpy(in, ct, 60);
+    if ((0 == AES_CCM_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 8)) && (0 == memcmp((char*) out, (char*) in, 60))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_ocb(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xbc, 0xdb, 0x92, 0xf4, 0x56, 0xeb, 0x99, 0xbb, 0x29, 0x05, 0x1d, 0x3f, 0x6f, 0x02, 0x35, 0x2c,
+                       0xdd, 0x6b, 0xe8, 0xaf, 0xc3, 0xa5, 0x70, 0x86, 0xa5, 0x77, 0xdc, 0x0c, 0xc7, 0xf1, 0x60, 0x8e,
+                       0x83, 0x1d, 0xe1, 0x19, 0x27, 0x3c, 0xe5, 0x07, 0x49, 0xfe, 0xca, 0x2e, 0xb6, 0xb5, 0x16, 0xea,
+                       0x89, 0xa3, 0x12, 0xb4, 0x94, 0x90, 0x9f, 0x58, 0x0e, 0xe5, 0xb7, 0x8c };
+    uint8_t tag[16] = { 0x32, 0x36, 0x15, 0x04, 0xe5, 0x1b, 0xdf, 0x2e, 0x13, 0x31, 0x98, 0xf4, 0x25, 0x0d, 0xc9, 0x24 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x40, 0x86, 0xec, 0x62, 0x38, 0x5a, 0x53, 0x67, 0xf9, 0xad, 0xb5, 0xa2, 0x5d, 0xa6, 0xa2, 0x22,
+                       0x33, 0xa0, 0xc2, 0xe9, 0x7e, 0xb0, 0xb8, 0x20, 0x7e, 0xea, 0x55, 0xc9, 0x40, 0xa0, 0x4a, 0x33,
+                       0x79, 0xc0, 0xe9, 0x2e, 0x27, 0x7e, 0xdb, 0xcb, 0x49, 0x9e, 0xb3, 0xa8, 0x88, 0xe1, 0x6e, 0x05,
+                       0xeb, 0x7a, 0xa2, 0x6d, 0xd8, 0x24, 0xeb, 0x7f, 0xf8, 0x75, 0xcb, 0x3a };
+    uint8_t tag[16] = { 0xe8, 0x09, 0x3c, 0xa5, 0xa2, 0x44, 0x76, 0xa2, 0xcd, 0x69, 0x60, 0x44, 0xc6, 0xf5, 0xf5, 0xd0 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x23, 0x5a, 0x4f, 0x4f, 0x7b, 0x3c, 0x85, 0xac, 0xbb, 0x4e, 0x3a, 0xa1, 0xdd, 0x5b, 0x99, 0x1b,
+                       0x99, 0x40, 0x03, 0xe2, 0x0b, 0xa9, 0x50, 0xd0, 0xc6, 0x33, 0xfa, 0xe2, 0xdf, 0x83, 0xad, 0xc2,
+                       0x94, 0x1a, 0x67, 0xac, 0xde, 0x1d, 0xb9, 0xb1, 0x36, 0x4d, 0x88, 0xdd, 0xa1, 0x30, 0xa9, 0xf9,
+                       0xf2, 0x16, 0x0a, 0x48, 0x0a, 0x8c, 0x3d, 0xbe, 0xbf, 0xe9, 0x74, 0x64 };
+    uint8_t tag[16] = { 0xd4, 0xd3, 0xb9, 0x4f, 0xf0, 0x34, 0x06, 0xf4, 0xef, 0x41, 0xf9, 0xfb, 0xba, 0x47, 0x24, 0xa1 };
+#endif
+    uint8_t nonce[12] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_OCB_ctx ctx;
+
+    AES_OCB_init_ctx(&ctx, key);
+    AES_OCB_encrypt_buffer(&ctx, nonce, 12, aad, 20, in, 60, out_tag, 16);
+
+    printf("OCB encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_ocb(void)
+{
+    // 15 byte nonce and truncated 12 byte tag
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x15, 0x15, 0xfb, 0x5c, 0x55, 0xd7, 0xf9, 0x2b, 0x01, 0x01, 0x7e, 0xc1, 0x8c, 0xf9, 0x82, 0xdc,
+                       0x00, 0x2c, 0x02, 0x23, 0x14, 0x9a, 0xf3, 0x34, 0x42, 0x73, 0x2e, 0xb5, 0x9c, 0x59, 0xd0, 0xec,
+                       0x70, 0xbf, 0xf3, 0x4d, 0x07, 0xbb, 0x31, 0x91, 0x3b, 0x4b, 0xb6, 0xbb, 0xb2, 0x15, 0x4d, 0x60,
+                       0xce, 0xa6, 0xad, 0x31, 0xb8, 0xcc, 0x67, 0x98, 0xa2, 0xda, 0xd1, 0x41 };
+    uint8_t tag[12] = { 0x85, 0xf4, 0x56, 0xfe, 0x5b, 0x14, 0x64, 0x64, 0xa0, 0xfb, 0xd6, 0x39 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x99, 0xac, 0x82, 0xd2, 0x4d, 0x7e, 0x5e, 0x98, 0x3c, 0xf1, 0x3c, 0x5b, 0xd1, 0xfd, 0x14, 0xe9,
+                       0x54, 0xaa, 0x8e, 0x2b, 0x38, 0xd1, 0x66, 0x14, 0xe0, 0xc2, 0xc2, 0x96, 0x47, 0x20, 0x7b, 0x49,
+                       0x3a, 0xdd, 0xa1, 0xd1, 0xc5, 0x85, 0x51, 0x76, 0x0f, 0xe0, 0x89, 0xeb, 0x44, 0xc1, 0x1b, 0xf8,
+                       0xa4, 0x63, 0xbc, 0x84, 0x25, 0xd2, 0x88, 0xc5, 0x80, 0x1d, 0x4e, 0x72 };
+    uint8_t tag[12] = { 0x5e, 0x6b, 0x5b, 0x40, 0xed, 0xb3, 0x22, 0xd4, 0x22, 0x8f, 0x8b, 0x0c };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0xdb, 0xc1, 0xae, 0xb7, 0xf6, 0x9f, 0xe8, 0xae, 0xc8, 0x15, 0xf0, 0x44, 0x79, 0x24, 0x1f, 0x94,
+                       0xf4, 0x99, 0xa1, 0xcb, 0xb2, 0x4e, 0x9c, 0x92, 0xc6, 0xe8, 0x89, 0x96, 0xef, 0xa0, 0xb5, 0x82,
+                       0xce, 0xb3, 0xd7, 0x64, 0xda, 0x68, 0x88, 0x3c, 0xbf, 0xe5, 0x11, 0x09, 0x2f, 0xe4, 0x85, 0x79,
+                       0x2b, 0xb7, 0xbd, 0x74, 0x2e, 0x8f, 0xb9, 0x46, 0x8c, 0xc4, 0xee, 0xd1 };
+    uint8_t tag[12] = { 0xad, 0x17, 0xaa, 0x92, 0xa7, 0xd3, 0xb8, 0x5d, 0x19, 0x29, 0x8b, 0x5a };
+#endif
+    uint8_t nonce[15] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xab, 0xcd, 0xef };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t in[60];
+    struct AES_OCB_ctx ctx;
+
+    AES_OCB_init_ctx(&ctx, key);
+
+    printf("OCB decrypt: ");
+
+    // a modified tag must be rejected
+    memcpy(in, ct, 60);
+    tag[11] ^= 0x01;
+    if (0 == AES_OCB_decrypt_buffer(&ctx, nonce, 15, aad, 20, in, 60, tag, 12)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    tag[11] ^= 0x01;
+
+    // so must tag and nonce lengths outside 1..16 and 1..15
+    memcpy(in, ct, 60);
+    if ((0 == AES_OCB_decrypt_buffer(&ctx, nonce, 15, aad, 20, in, 60, tag, 0)) ||
+        (0 == AES_OCB_decrypt_buffer(&ctx, nonce, 15, aad, 20, in, 60, tag, 17)) ||
+        (0 == AES_OCB_decrypt_buffer(&ctx, nonce, 0, aad, 20, in, 60, tag, 12)) ||
+        (0 == AES_OCB_decrypt_buffer(&ctx, nonce, 16, aad, 20, in, 60, tag, 12))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    memcpy(in, ct, 60);
+    if ((0 == AES_OCB_decrypt_buffer(&ctx, nonce, 15, aad, 20, in, 60, tag, 12)) && (0 == memcmp((char*) out, (char*) in, 60))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_xts(void)
+{
+#if defined(AES256)
+    uint8_t key[64] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+                        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[64] = { 0x5c, 0x3e, 0xee, 0xc4, 0x47, 0x28, 0x26, 0x4a, 0x25, 0x57, 0x7a, 0x5b, 0xeb, 0x70, 0x34, 0x30,
+                       0x95, 0x61, 0xb5, 0xa4, 0xbc, 0xe0, 0xd9, 0xc8, 0xe7, 0xc0, 0xd7, 0x4f, 0x68, 0xcf, 0x31, 0x1b,
+                       0x4e, 0x70, 0xaa, 0x90, 0x11, 0xee, 0x93, 0x00, 0x31, 0x94, 0xe6, 0x25, 0xca, 0x69, 0x25, 0x61,
+                       0xf9, 0x31, 0xec, 0xdd, 0xc4, 0x31, 0xa1, 0x14, 0x8e, 0x33, 0x34, 0xf2, 0xca, 0x2c, 0x75, 0xed };
+#elif defined(AES192)
+    uint8_t key[48] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[64] = { 0xf2, 0xe9, 0xe2, 0x6f, 0x21, 0xc8, 0x3e, 0x32, 0x3f, 0xa1, 0x0e, 0x26, 0x83, 0x16, 0xb5, 0xd7,
+                       0xe9, 0x3d, 0x98, 0xf4, 0x86, 0x3a, 0x12, 0x18, 0x6d, 0x8e, 0x8e, 0xa4, 0x11, 0x1f, 0x5c, 0xf2,
+                       0x1f, 0x94, 0xa5, 0xc8, 0xb9, 0xab, 0x2c, 0x00, 0xc5, 0x2f, 0x43, 0x63, 0xbb, 0x9b, 0x87, 0x82,
+                       0xb7, 0x3e, 0xec, 0xc0, 0x9a, 0xc4, 0x63, 0x90, 0x65, 0x40, 0xfd, 0x99, 0x61, 0xe4, 0xf8, 0xd2 };
+#elif defined(AES128)
+    uint8_t key[32] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t ct[64] = { 0x45, 0x05, 0x5e, 0xa9, 0x1b, 0x60, 0x89, 0x2b, 0xab, 0x5f, 0xb0, 0x34, 0x75, 0x62, 0x11, 0x4b,
+                       0x3f, 0xf8, 0x77, 0x11, 0x4e, 0xc6, 0x21, 0x19, 0xbb, 0x37, 0x0c, 0x1e, 0x6d, 0x04, 0xd3, 0x75,
+                       0xcb, 0x97, 0x1b, 0x56, 0xe7, 0xc3, 0xd3, 0x1c, 0x89, 0xab, 0xe8, 0xb8, 0x5a, 0x7b, 0x22, 0x46,
+                       0x7b, 0x6e, 0xd7, 0xcc, 0x95, 0xec, 0x35, 0x23, 0xeb, 0x63, 0x4a, 0x68, 0x08, 0x5b, 0x25, 0x66 };
+#endif
+    uint8_t in[64]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    struct AES_XTS_ctx ctx;
+
+    AES_XTS_init_ctx(&ctx, key);
+    AES_XTS_encrypt_buffer(&ctx, 0x123456789a, in, 15); // too short, leaves buf unchanged
+    AES_XTS_encrypt_sectors(&ctx, 0x123456789a, in, 15, 2);
+    AES_XTS_encrypt_sectors(&ctx, 0x123456789a, in, 32, 2);
 
+    printf("XTS encrypt: ");
+
+    if (0 == memcmp((char*) ct, (char*) in, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_xts(void)
+{
+#if defined(AES256)
+    uint8_t key[64] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+                        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x4b, 0x12, 0xa6, 0x9f, 0x27, 0xc2, 0xd7, 0x1f, 0xf9, 0x26, 0x83, 0x07, 0x40, 0xa0, 0x07, 0xfb,
+                       0x1a, 0x66, 0xdc, 0x25, 0x32, 0x41, 0x32, 0xb3, 0x37, 0x28, 0x83, 0x59, 0xea, 0x74, 0xeb, 0x77,
+                       0x3e, 0x1d, 0x91, 0xb5, 0xce, 0x25, 0xa1, 0x3f, 0x61, 0x35, 0xda, 0x11, 0x22, 0x48, 0x17, 0x20,
+                       0x53, 0xa5, 0x25, 0xbf, 0x63, 0x5d, 0x64, 0x03, 0x1d, 0xb5, 0x5a, 0xa0 };
+#elif defined(AES192)
+    uint8_t key[48] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x8c, 0xdb, 0xb4, 0x63, 0x92, 0x83, 0x90, 0xab, 0x62, 0x35, 0x0c, 0xe6, 0x3d, 0xb4, 0x4d, 0x25,
+                       0x7f, 0xd1, 0x38, 0xb6, 0x88, 0xcf, 0x5f, 0x26, 0x7b, 0x55, 0x14, 0x4e, 0x82, 0xf8, 0xa1, 0x1c,
+                       0x07, 0x4d, 0x65, 0x3d, 0xf8, 0x06, 0x16, 0x43, 0x00, 0xc4, 0x09, 0x47, 0x22, 0xc7, 0xea, 0xef,
+                       0x51, 0x4e, 0x20, 0x94, 0x8a, 0xde, 0x36, 0xee, 0x15, 0xb5, 0xee, 0x85 };
+#elif defined(AES128)
+    uint8_t key[32] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t ct[60] = { 0x92, 0x3d, 0x00, 0x37, 0x3a, 0xd2, 0x61, 0x6b, 0x0c, 0xc4, 0x30, 0x36, 0xb1, 0x98, 0xf6, 0x85,
+                       0x2f, 0xe9, 0xd1, 0x85, 0x8e, 0xa4, 0xbd, 0x63, 0xc8, 0x64, 0x6d, 0x3e, 0xf6, 0xa7, 0xc9, 0xfa,
+                       0x3b, 0x26, 0xbe, 0x1f, 0x18, 0x9b, 0xea, 0x8a, 0x14, 0x79, 0x14, 0xfc, 0x84, 0x98, 0x1d, 0x69,
+                       0x61, 0x0c, 0x33, 0x65, 0x9f, 0xd4, 0xdf, 0x4f, 0xbd, 0x74, 0x50, 0x9c };
+#endif
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_XTS_ctx ctx;
+
+    AES_XTS_init_ctx(&ctx, key);
+    AES_XTS_decrypt_buffer(&ctx, 7, ct, 60);
+
+    printf("XTS decrypt: ");
+
+    if (0 == memcmp((char*) out, (char*) ct, 60)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_cfb(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[64] = { 0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b, 0x7e, 0xcd, 0x84, 0x86, 0x98, 0x5d, 0x38, 0x60,
+                       0x39, 0xff, 0xed, 0x14, 0x3b, 0x28, 0xb1, 0xc8, 0x32, 0x11, 0x3c, 0x63, 0x31, 0xe5, 0x40, 0x7b,
+                       0xdf, 0x10, 0x13, 0x24, 0x15, 0xe5, 0x4b, 0x92, 0xa1, 0x3e, 0xd0, 0xa8, 0x26, 0x7a, 0xe2, 0xf9,
+                       0x75, 0xa3, 0x85, 0x74, 0x1a, 0xb9, 0xce, 0xf8, 0x20, 0x31, 0x62, 0x3d, 0x55, 0xb1, 0xe4, 0x71 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[64] = { 0xcd, 0xc8, 0x0d, 0x6f, 0xdd, 0xf1, 0x8c, 0xab, 0x34, 0xc2, 0x59, 0x09, 0xc9, 0x9a, 0x41, 0x74,
+                       0x67, 0xce, 0x7f, 0x7f, 0x81, 0x17, 0x36, 0x21, 0x96, 0x1a, 0x2b, 0x70, 0x17, 0x1d, 0x3d, 0x7a,
+                       0x2e, 0x1e, 0x8a, 0x1d, 0xd5, 0x9b, 0x88, 0xb1, 0xc8, 0xe6, 0x0f, 0xed, 0x1e, 0xfa, 0xc4, 0xc9,
+                       0xc0, 0x5f, 0x9f, 0x9c, 0xa9, 0x83, 0x4f, 0xa0, 0x42, 0xae, 0x8f, 0xba, 0x58, 0x4b, 0x09, 0xff };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[64] = { 0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+                       0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f, 0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+                       0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40, 0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+                       0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e, 0xea, 0xc4, 0xc6, 0x6f, 0x9f, 0xf7, 0xf2, 0xe6 };
+#endif
+    uint8_t iv[16]  = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t in[64]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_CFB_encrypt_buffer(&ctx, in, 16);
+    AES_CFB_encrypt_buffer(&ctx, in + 16, 48);
+
+    printf("CFB encrypt: ");
+
+    if (0 == memcmp((char*) ct, (char*) in, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_cfb(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b, 0x7e, 0xcd, 0x84, 0x86, 0x98, 0x5d, 0x38, 0x60,
+                       0x39, 0xff, 0xed, 0x14, 0x3b, 0x28, 0xb1, 0xc8, 0x32, 0x11, 0x3c, 0x63, 0x31, 0xe5, 0x40, 0x7b,
+                       0xdf, 0x10, 0x13, 0x24, 0x15, 0xe5, 0x4b, 0x92, 0xa1, 0x3e, 0xd0, 0xa8, 0x26, 0x7a, 0xe2, 0xf9,
+                       0x75, 0xa3, 0x85, 0x74, 0x1a, 0xb9, 0xce, 0xf8, 0x20, 0x31, 0x62, 0x3d };
+    uint8_t ct8[18] = { 0xdc, 0x1f, 0x1a, 0x85, 0x20, 0xa6, 0x4d, 0xb5, 0x5f, 0xcc, 0x8a, 0xc5, 0x54, 0x84, 0x4e, 0x88,
+                        0x97, 0x00 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0xcd, 0xc8, 0x0d, 0x6f, 0xdd, 0xf1, 0x8c, 0xab, 0x34, 0xc2, 0x59, 0x09, 0xc9, 0x9a, 0x41, 0x74,
+                       0x67, 0xce, 0x7f, 0x7f, 0x81, 0x17, 0x36, 0x21, 0x96, 0x1a, 0x2b, 0x70, 0x17, 0x1d, 0x3d, 0x7a,
+                       0x2e, 0x1e, 0x8a, 0x1d, 0xd5, 0x9b, 0x88, 0xb1, 0xc8, 0xe6, 0x0f, 0xed, 0x1e, 0xfa, 0xc4, 0xc9,
+                       0xc0, 0x5f, 0x9f, 0x9c, 0xa9, 0x83, 0x4f, 0xa0, 0x42, 0xae, 0x8f, 0xba };
+    uint8_t ct8[18] = { 0xcd, 0xa2, 0x52, 0x1e, 0xf0, 0xa9, 0x05, 0xca, 0x44, 0xcd, 0x05, 0x7c, 0xbf, 0x0d, 0x47, 0xa0,
+                        0x67, 0x8a };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+                       0xc8, 0xa6, 0x45, 0x37, 0xa0, 0xb3, 0xa9, 0x3f, 0xcd, 0xe3, 0xcd, 0xad, 0x9f, 0x1c, 0xe5, 0x8b,
+                       0x26, 0x75, 0x1f, 0x67, 0xa3, 0xcb, 0xb1, 0x40, 0xb1, 0x80, 0x8c, 0xf1, 0x87, 0xa4, 0xf4, 0xdf,
+                       0xc0, 0x4b, 0x05, 0x35, 0x7c, 0x5d, 0x1c, 0x0e, 0xea, 0xc4, 0xc6, 0x6f };
+    uint8_t ct8[18] = { 0x3b, 0x79, 0x42, 0x4c, 0x9c, 0x0d, 0xd4, 0x36, 0xba, 0xce, 0x9e, 0x0e, 0xd4, 0x58, 0x6a, 0x4f,
+                        0x32, 0xb9 };
+#endif
+    uint8_t iv[16]  = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_CFB_decrypt_buffer(&ctx, ct, 60);
+    AES_ctx_set_iv(&ctx, iv);
+    AES_CFB8_decrypt_buffer(&ctx, ct8, 18);
+
+    printf("CFB decrypt: ");
+
+    if ((0 == memcmp((char*) out, (char*) ct, 60)) && (0 == memcmp((char*) out, (char*) ct8, 18))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_xcrypt_ofb(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xdc, 0x7e, 0x84, 0xbf, 0xda, 0x79, 0x16, 0x4b, 0x7e, 0xcd, 0x84, 0x86, 0x98, 0x5d, 0x38, 0x60,
+                       0x4f, 0xeb, 0xdc, 0x67, 0x40, 0xd2, 0x0b, 0x3a, 0xc8, 0x8f, 0x6a, 0xd8, 0x2a, 0x4f, 0xb0, 0x8d,
+                       0x71, 0xab, 0x47, 0xa0, 0x86, 0xe8, 0x6e, 0xed, 0xf3, 0x9d, 0x1c, 0x5b, 0xba, 0x97, 0xc4, 0x08,
+                       0x01, 0x26, 0x14, 0x1d, 0x67, 0xf3, 0x7b, 0xe8, 0x53, 0x8f, 0x5a, 0x8b };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0xcd, 0xc8, 0x0d, 0x6f, 0xdd, 0xf1, 0x8c, 0xab, 0x34, 0xc2, 0x59, 0x09, 0xc9, 0x9a, 0x41, 0x74,
+                       0xfc, 0xc2, 0x8b, 0x8d, 0x4c, 0x63, 0x83, 0x7c, 0x09, 0xe8, 0x17, 0x00, 0xc1, 0x10, 0x04, 0x01,
+                       0x8d, 0x9a, 0x9a, 0xea, 0xc0, 0xf6, 0x59, 0x6f, 0x55, 0x9c, 0x6d, 0x4d, 0xaf, 0x59, 0xa5, 0xf2,
+                       0x6d, 0x9f, 0x20, 0x08, 0x57, 0xca, 0x6c, 0x3e, 0x9c, 0xac, 0x52, 0x4b };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x3b, 0x3f, 0xd9, 0x2e, 0xb7, 0x2d, 0xad, 0x20, 0x33, 0x34, 0x49, 0xf8, 0xe8, 0x3c, 0xfb, 0x4a,
+                       0x77, 0x89, 0x50, 0x8d, 0x16, 0x91, 0x8f, 0x03, 0xf5, 0x3c, 0x52, 0xda, 0xc5, 0x4e, 0xd8, 0x25,
+                       0x97, 0x40, 0x05, 0x1e, 0x9c, 0x5f, 0xec, 0xf6, 0x43, 0x44, 0xf7, 0xa8, 0x22, 0x60, 0xed, 0xcc,
+                       0x30, 0x4c, 0x65, 0x28, 0xf6, 0x59, 0xc7, 0x78, 0x66, 0xa5, 0x10, 0xd9 };
+#endif
+    uint8_t iv[16]  = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_OFB_xcrypt_buffer(&ctx, in, 60);
+
+    printf("OFB xcrypt: ");
+
+    if (0 == memcmp((char*) ct, (char*) in, 60)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cmac(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t mac[16] = { 0xaa, 0xf3, 0xd8, 0xf1, 0xde, 0x56, 0x40, 0xc2, 0x32, 0xf5, 0xb1, 0x69, 0xb9, 0xc9, 0x11, 0xe6 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t mac[16] = { 0x8a, 0x1d, 0xe5, 0xbe, 0x2e, 0xb3, 0x1a, 0xad, 0x08, 0x9a, 0x82, 0xe6, 0xee, 0x90, 0x8b, 0x0e };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t mac[16] = { 0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27 };
+#endif
+    uint8_t msg[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t out[16];
+    struct AES_CMAC_ctx ctx;
+
+    AES_CMAC_init_ctx(&ctx, key);
+    AES_CMAC_buffer(&ctx, msg, 40, out);
+
+    printf("CMAC: ");
+
+    if (0 == memcmp((char*) mac, (char*) out, 16)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cmac_buffers(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t macs[80] = { 0x02, 0x89, 0x62, 0xf6, 0x1b, 0x7b, 0xf8, 0x9e, 0xfc, 0x6b, 0x55, 0x1f, 0x46, 0x67, 0xd9, 0x83,
+                         0x28, 0xa7, 0x02, 0x3f, 0x45, 0x2e, 0x8f, 0x82, 0xbd, 0x4b, 0xf2, 0x8d, 0x8c, 0x37, 0xc3, 0x5c,
+                         0xaa, 0xf3, 0xd8, 0xf1, 0xde, 0x56, 0x40, 0xc2, 0x32, 0xf5, 0xb1, 0x69, 0xb9, 0xc9, 0x11, 0xe6,
+                         0xe1, 0x99, 0x21, 0x90, 0x54, 0x9f, 0x6e, 0xd5, 0x69, 0x6a, 0x2c, 0x05, 0x6c, 0x31, 0x54, 0x10,
+                         0x41, 0xcc, 0x34, 0xc2, 0x0a, 0xdf, 0x82, 0x8f, 0x48, 0x96, 0xc8, 0xd1, 0x9f, 0xab, 0x40, 0x2d };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t macs[80] = { 0xd1, 0x7d, 0xdf, 0x46, 0xad, 0xaa, 0xcd, 0xe5, 0x31, 0xca, 0xc4, 0x83, 0xde, 0x7a, 0x93, 0x67,
+                         0x9e, 0x99, 0xa7, 0xbf, 0x31, 0xe7, 0x10, 0x90, 0x06, 0x62, 0xf6, 0x5e, 0x61, 0x7c, 0x51, 0x84,
+                         0x8a, 0x1d, 0xe5, 0xbe, 0x2e, 0xb3, 0x1a, 0xad, 0x08, 0x9a, 0x82, 0xe6, 0xee, 0x90, 0x8b, 0x0e,
+                         0xa1, 0xd5, 0xdf, 0x0e, 0xed, 0x79, 0x0f, 0x79, 0x4d, 0x77, 0x58, 0x96, 0x59, 0xf3, 0x9a, 0x11,
+                         0xee, 0x0f, 0x57, 0x19, 0x6f, 0x1c, 0x16, 0xa8, 0x82, 0xdd, 0x15, 0x39, 0x42, 0xb4, 0x20, 0xfd };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t macs[80] = { 0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46,
+                         0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c,
+                         0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27,
+                         0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe,
+                         0xbc, 0x72, 0xcc, 0x16, 0x8e, 0xc5, 0xa1, 0x43, 0x4d, 0xcd, 0xb2, 0x0b, 0xc1, 0xa2, 0xc2, 0xa4 };
+#endif
+    uint8_t msg[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    const uint8_t* msgs[5] = { msg, msg, msg, msg, msg };
+    size_t lengths[5] = { 0, 16, 40, 64, 17 };
+    uint8_t out[80];
+    struct AES_CMAC_ctx ctx;
+
+    AES_CMAC_init_ctx(&ctx, key);
+    AES_CMAC_buffers(&ctx, msgs, lengths, 5, out);
+
+    printf("CMAC batch: ");
+
+    if (0 == memcmp((char*) macs, (char*) out, 80)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_gcm_siv(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x1c, 0x2e, 0xc8, 0x3c, 0x68, 0x0d, 0xe0, 0x3e, 0xec, 0x2e, 0x43, 0x37, 0xd6, 0xfa, 0x46, 0xc9,
+                       0x33, 0xe7, 0xf6, 0x33, 0xda, 0xe7, 0x4a, 0x98, 0x91, 0x33, 0x61, 0x5f, 0x5e, 0x3b, 0x3b, 0x82,
+                       0x8e, 0x7d, 0xa7, 0x6b, 0x4c, 0x83, 0x55, 0x7e, 0x71, 0x5e, 0x2f, 0xb6, 0xf3, 0x04, 0x2e, 0xde,
+                       0x49, 0x2a, 0xf7, 0x4f, 0xbe, 0x02, 0x77, 0x18, 0x49, 0xec, 0x15, 0x72 };
+    uint8_t tag[16] = { 0x24, 0x26, 0x6c, 0xd3, 0xf0, 0x17, 0xf6, 0xc7, 0x1e, 0x50, 0x1c, 0x7e, 0x0a, 0x52, 0x1e, 0x83 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x45, 0xb6, 0x98, 0x0e, 0x44, 0x6d, 0x8d, 0xfc, 0x51, 0x46, 0x46, 0x87, 0x79, 0x8d, 0x7a, 0x74,
+                       0x23, 0xe7, 0x20, 0xb2, 0x93, 0xf8, 0xd4, 0x33, 0x1f, 0x66, 0x24, 0x2f, 0xc1, 0xdc, 0x75, 0xfd,
+                       0x88, 0xb4, 0xb8, 0xfb, 0x4b, 0xab, 0x77, 0x43, 0x03, 0xf8, 0xc9, 0x50, 0x02, 0x44, 0xf0, 0x29,
+                       0x31, 0x5e, 0x75, 0x85, 0xa6, 0xc5, 0x30, 0x98, 0xfb, 0x93, 0xbe, 0x66 };
+    uint8_t tag[16] = { 0x4e, 0x18, 0xcb, 0xa9, 0x9e, 0xe3, 0x78, 0xb7, 0x13, 0x9f, 0x1c, 0xcb, 0xa9, 0x32, 0x91, 0x29 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0xcf, 0x14, 0xf1, 0x7e, 0x6a, 0x8c, 0x24, 0xbf, 0xc8, 0x31, 0xe7, 0xed, 0x53, 0x9b, 0x14, 0x0f,
+                       0x3e, 0xf3, 0x1d, 0x5c, 0xdc, 0xc3, 0x00, 0x9d, 0xad, 0x62, 0xc1, 0x58, 0x91, 0xbe, 0x33, 0xc8,
+                       0x1f, 0x6d, 0xad, 0x9b, 0xf0, 0x7d, 0x7a, 0xb4, 0x60, 0x59, 0x00, 0x74, 0x82, 0x0e, 0x1c, 0x81,
+                       0x49, 0x45, 0xa4, 0x64, 0xe2, 0xb2, 0xfe, 0x7c, 0x84, 0xe7, 0x36, 0x95 };
+    uint8_t tag[16] = { 0x98, 0x27, 0x3b, 0x30, 0xc0, 0x35, 0x68, 0xec, 0x74, 0xdf, 0x12, 0xc6, 0x09, 0xc6, 0x69, 0xc0 };
+#endif
+    uint8_t iv[12]  = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+    AES_GCM_SIV_encrypt_buffer(&ctx, iv, aad, 20, in, 60, out_tag);
+
+    printf("GCM-SIV encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_gcm_siv(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[64] = { 0x90, 0xce, 0x04, 0xb3, 0x2a, 0xa0, 0x59, 0xaa, 0xfc, 0x74, 0x20, 0xc2, 0xb9, 0x53, 0x88, 0x77,
+                       0x44, 0x8d, 0x3c, 0x2e, 0x1c, 0x76, 0xba, 0x52, 0xae, 0x65, 0xba, 0x47, 0x0f, 0x4b, 0x5d, 0x96,
+                       0x50, 0x3e, 0xc7, 0x26, 0x3e, 0xf9, 0x86, 0x94, 0xa7, 0x2a, 0xc7, 0x2d, 0x40, 0xb3, 0x23, 0x64,
+                       0x9a, 0x9e, 0xe3, 0xd0, 0x7a, 0x77, 0xaf, 0x9c, 0x0c, 0xdc, 0x76, 0x47, 0xb2, 0x1c, 0x94, 0xb5 };
+    uint8_t tag[16] = { 0xef, 0x2d, 0x4a, 0x62, 0x2d, 0x8a, 0x22, 0x38, 0xa5, 0xce, 0x5a, 0x23, 0xb7, 0xf8, 0xc2, 0x73 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[64] = { 0x3e, 0x8e, 0xaf, 0x58, 0x97, 0x6a, 0x78, 0xec, 0xfc, 0x38, 0x27, 0x32, 0xea, 0x6c, 0x89, 0xed,
+                       0x05, 0xe4, 0x69, 0xad, 0xce, 0x52, 0xf6, 0x46, 0x8c, 0x81, 0xee, 0x48, 0x34, 0x66, 0x1d, 0x01,
+                       0x7f, 0xd4, 0x13, 0x8e, 0x9a, 0xd2, 0x81, 0x79, 0x49, 0xd8, 0xbe, 0x33, 0x4a, 0x83, 0xa7, 0x74,
+                       0xf0, 0x16, 0x7a, 0x91, 0x44, 0x84, 0xc9, 0x3c, 0x20, 0xa9, 0x9f, 0x2e, 0x52, 0x3b, 0xc2, 0x75 };
+    uint8_t tag[16] = { 0x36, 0xd1, 0x84, 0xe2, 0x16, 0xc2, 0x64, 0x1e, 0xae, 0xf4, 0x3e, 0xdd, 0x0c, 0xbb, 0x0f, 0xe8 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[64] = { 0x2a, 0xae, 0x44, 0xf1, 0x34, 0xcd, 0x83, 0xfa, 0x2c, 0xb2, 0x33, 0x72, 0xe2, 0x40, 0x5d, 0x6c,
+                       0x78, 0x81, 0x44, 0x49, 0x03, 0xdc, 0xbe, 0x0d, 0x32, 0x3b, 0x8e, 0x0f, 0x75, 0xba, 0xc4, 0xeb,
+                       0x01, 0x0f, 0xcc, 0x77, 0x82, 0x2f, 0xd4, 0x76, 0x78, 0xb9, 0x6f, 0x37, 0xa2, 0x7d, 0x91, 0x5f,
+                       0xf5, 0x26, 0xca, 0x0d, 0x2d, 0x5a, 0x4a, 0xfb, 0x96, 0x3f, 0x2b, 0x50, 0x72, 0xe8, 0x2f, 0x83 };
+    uint8_t tag[16] = { 0x95, 0xd1, 0x77, 0x5b, 0x6d, 0xe2, 0x95, 0x89, 0x9e, 0x61, 0xd4, 0xbc, 0x04, 0x40, 0x2a, 0x96 };
+#endif
+    uint8_t iv[12]  = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+    uint8_t out[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t in[64];
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+
+    printf("GCM-SIV decrypt: ");
+
+    // a modified ciphertext must be rejected
+    memcpy(in, ct, 64);
+    in[0] ^= 0x01;
+    if (0 == AES_GCM_SIV_decrypt_buffer(&ctx, iv, 0, 0, in, 64, tag)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    memcpy(in, ct, 64);
+    if ((0 == AES_GCM_SIV_decrypt_buffer(&ctx, iv, 0, 0, in, 64, tag)) && (0 == memcmp((char*) out, (char*) in, 64))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_siv(void)
+{
+#if defined(AES256)
+    uint8_t key[64] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+                        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t tag[16] = { 0x4d, 0x95, 0xdd, 0x58, 0x69, 0x38, 0x23, 0x29, 0x7d, 0x44, 0xe9, 0x1d, 0x42, 0x91, 0x71, 0xc9 };
+    uint8_t ct[60] = { 0x33, 0x3c, 0x60, 0xe0, 0x97, 0xb1, 0xf6, 0xc9, 0x16, 0x33, 0xfa, 0x46, 0x8a, 0x32, 0x23, 0x6d,
+                       0x4f, 0x3f, 0x17, 0x82, 0x12, 0xca, 0x3e, 0xf1, 0x88, 0x6e, 0xa5, 0x74, 0x61, 0x2a, 0xcc, 0xf7,
+                       0x52, 0x82, 0x3b, 0xe0, 0xde, 0xfe, 0xc0, 0x88, 0xb6, 0xe6, 0xc6, 0x06, 0x21, 0xbb, 0xe5, 0x48,
+                       0x16, 0x4c, 0xe1, 0x38, 0x15, 0xb3, 0xa6, 0x9e, 0xdd, 0x2e, 0xcb, 0x09 };
+#elif defined(AES192)
+    uint8_t key[48] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t tag[16] = { 0x03, 0x3c, 0x1b, 0xd4, 0xec, 0xa9, 0xf0, 0x68, 0xe9, 0xd5, 0xcf, 0x6e, 0x7f, 0xae, 0x22, 0xdc };
+    uint8_t ct[60] = { 0x52, 0x25, 0x7c, 0xe0, 0x73, 0x8b, 0x21, 0xc1, 0xda, 0x6c, 0xc1, 0x18, 0x61, 0x34, 0x4e, 0xf4,
+                       0x09, 0x3f, 0xc1, 0xdf, 0x35, 0xf0, 0xe3, 0x7c, 0xf0, 0x2c, 0x70, 0xec, 0x7d, 0x50, 0xf4, 0xbb,
+                       0x25, 0x3b, 0x91, 0x3d, 0xa0, 0x34, 0x6f, 0x31, 0x1c, 0x92, 0xe9, 0x43, 0x83, 0xc7, 0x5a, 0xed,
+                       0x75, 0x5e, 0x15, 0x7a, 0x16, 0x6e, 0x2f, 0x7c, 0x48, 0x93, 0xe2, 0x41 };
+#elif defined(AES128)
+    uint8_t key[32] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t tag[16] = { 0xce, 0xc1, 0xf7, 0x4e, 0x3d, 0x2b, 0xf8, 0xa3, 0x1b, 0x04, 0x0b, 0xbb, 0x99, 0xef, 0xd0, 0x54 };
+    uint8_t ct[60] = { 0x7f, 0x76, 0x6e, 0x4a, 0xee, 0xdf, 0xaf, 0x36, 0x5c, 0x38, 0xd2, 0x37, 0x78, 0x94, 0x4b, 0xca,
+                       0x5b, 0x37, 0x2f, 0x67, 0xc0, 0x6a, 0x16, 0x22, 0xb0, 0x47, 0x7a, 0xeb, 0xf9, 0x90, 0xa1, 0xea,
+                       0x0c, 0xa2, 0x5e, 0xc9, 0x87, 0x6d, 0x2a, 0x82, 0x47, 0x0e, 0x14, 0x49, 0x60, 0xfa, 0x76, 0x9e,
+                       0x7d, 0xd0, 0x69, 0x04, 0x51, 0x3c, 0xdf, 0x63, 0x13, 0x51, 0xd2, 0xdd };
+#endif
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_SIV_ctx ctx;
+
+    AES_SIV_init_ctx(&ctx, key);
+    AES_SIV_encrypt_buffer(&ctx, aad, 20, in, 60, out_tag);
+
+    printf("SIV encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_siv(void)
+{
+#if defined(AES256)
+    uint8_t key[64] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+                        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t tag[16] = { 0x4d, 0x95, 0xdd, 0x58, 0x69, 0x38, 0x23, 0x29, 0x7d, 0x44, 0xe9, 0x1d, 0x42, 0x91, 0x71, 0xc9 };
+    uint8_t ct[60] = { 0x33, 0x3c, 0x60, 0xe0, 0x97, 0xb1, 0xf6, 0xc9, 0x16, 0x33, 0xfa, 0x46, 0x8a, 0x32, 0x23, 0x6d,
+                       0x4f, 0x3f, 0x17, 0x82, 0x12, 0xca, 0x3e, 0xf1, 0x88, 0x6e, 0xa5, 0x74, 0x61, 0x2a, 0xcc, 0xf7,
+                       0x52, 0x82, 0x3b, 0xe0, 0xde, 0xfe, 0xc0, 0x88, 0xb6, 0xe6, 0xc6, 0x06, 0x21, 0xbb, 0xe5, 0x48,
+                       0x16, 0x4c, 0xe1, 0x38, 0x15, 0xb3, 0xa6, 0x9e, 0xdd, 0x2e, 0xcb, 0x09 };
+#elif defined(AES192)
+    uint8_t key[48] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t tag[16] = { 0x03, 0x3c, 0x1b, 0xd4, 0xec, 0xa9, 0xf0, 0x68, 0xe9, 0xd5, 0xcf, 0x6e, 0x7f, 0xae, 0x22, 0xdc };
+    uint8_t ct[60] = { 0x52, 0x25, 0x7c, 0xe0, 0x73, 0x8b, 0x21, 0xc1, 0xda, 0x6c, 0xc1, 0x18, 0x61, 0x34, 0x4e, 0xf4,
+                       0x09, 0x3f, 0xc1, 0xdf, 0x35, 0xf0, 0xe3, 0x7c, 0xf0, 0x2c, 0x70, 0xec, 0x7d, 0x50, 0xf4, 0xbb,
+                       0x25, 0x3b, 0x91, 0x3d, 0xa0, 0x34, 0x6f, 0x31, 0x1c, 0x92, 0xe9, 0x43, 0x83, 0xc7, 0x5a, 0xed,
+                       0x75, 0x5e, 0x15, 0x7a, 0x16, 0x6e, 0x2f, 0x7c, 0x48, 0x93, 0xe2, 0x41 };
+#elif defined(AES128)
+    uint8_t key[32] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t tag[16] = { 0xce, 0xc1, 0xf7, 0x4e, 0x3d, 0x2b, 0xf8, 0xa3, 0x1b, 0x04, 0x0b, 0xbb, 0x99, 0xef, 0xd0, 0x54 };
+    uint8_t ct[60] = { 0x7f, 0x76, 0x6e, 0x4a, 0xee, 0xdf, 0xaf, 0x36, 0x5c, 0x38, 0xd2, 0x37, 0x78, 0x94, 0x4b, 0xca,
+                       0x5b, 0x37, 0x2f, 0x67, 0xc0, 0x6a, 0x16, 0x22, 0xb0, 0x47, 0x7a, 0xeb, 0xf9, 0x90, 0xa1, 0xea,
+                       0x0c, 0xa2, 0x5e, 0xc9, 0x87, 0x6d, 0x2a, 0x82, 0x47, 0x0e, 0x14, 0x49, 0x60, 0xfa, 0x76, 0x9e,
+                       0x7d, 0xd0, 0x69, 0x04, 0x51, 0x3c, 0xdf, 0x63, 0x13, 0x51, 0xd2, 0xdd };
+#endif
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t in[60];
+    struct AES_SIV_ctx ctx;
+
+    AES_SIV_init_ctx(&ctx, key);
+
+    printf("SIV decrypt: ");
+
+    // a modified tag must be rejected
+    memcpy(in, ct, 60);
+    tag[15] ^= 0x01;
+    if (0 == AES_SIV_decrypt_buffer(&ctx, aad, 20, in, 60, tag)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    tag[15] ^= 0x01;
+
+    memcpy(in, ct, 60);
+    if ((0 == AES_SIV_decrypt_buffer(&ctx, aad, 20, in, 60, tag)) && (0 == memcmp((char*) out, (char*) in, 60))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_siv_buffers(void)
+{
+    // values of 0, 5, 16, 17 and 64 bytes, without associated data
+#if defined(AES256)
+    uint8_t key[64] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4,
+                        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t pt[102] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d,
+                        0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7,
+                        0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+                        0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b,
+                        0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t tags[80] = { 0xc6, 0xca, 0xec, 0xe5, 0x90, 0xbd, 0x1e, 0xee, 0x50, 0xd6, 0xf5, 0x8b, 0x3d, 0x3e, 0x32, 0xda,
+                         0x9f, 0x55, 0x26, 0x48, 0x42, 0x6a, 0xbf, 0x4c, 0x7a, 0x12, 0x43, 0x83, 0x18, 0x82, 0xad, 0xec,
+                         0xf0, 0x50, 0x05, 0xb5, 0x5b, 0xff, 0xc4, 0xa5, 0xbe, 0x50, 0x3f, 0x47, 0x87, 0x92, 0x6b, 0xdd,
+                         0x3f, 0x05, 0x4e, 0xfe, 0xd9, 0x93, 0xe8, 0x3e, 0xac, 0x3e, 0x37, 0xc6, 0xf6, 0x0d, 0x69, 0x2a,
+                         0x0f, 0x9b, 0x5b, 0x5b, 0xbd, 0x24, 0x3a, 0xf8, 0x04, 0xc3, 0x4c, 0x68, 0xd2, 0xd9, 0x04, 0x05 };
+    uint8_t ct[102] = { 0x5a, 0x82, 0xaf, 0xdc, 0xad, 0xe9, 0x9d, 0xc5, 0xb5, 0xfa, 0xd5, 0x8f, 0x8d, 0xdb, 0x10, 0xec,
+                        0xb0, 0xeb, 0xb0, 0x55, 0x59, 0xf3, 0xf4, 0x23, 0x9d, 0xb8, 0x87, 0xde, 0x84, 0xcb, 0xbc, 0x36,
+                        0x6c, 0x7f, 0x67, 0x9f, 0x37, 0x7c, 0x4d, 0xc6, 0x0f, 0x24, 0xfc, 0x09, 0x19, 0x26, 0xc7, 0xb8,
+                        0x42, 0x0e, 0xf8, 0xd9, 0x58, 0x9f, 0x76, 0x01, 0x84, 0x24, 0x18, 0x5d, 0xb4, 0x55, 0xae, 0x98,
+                        0xed, 0x4d, 0xa2, 0x61, 0x16, 0xe4, 0xdf, 0x12, 0xe0, 0xb6, 0xd6, 0x3c, 0xc7, 0x21, 0x8b, 0x1b,
+                        0xf8, 0x08, 0xa1, 0x0d, 0xaa, 0xa0, 0x90, 0x9e, 0x2f, 0x9e, 0xb7, 0x53, 0x0c, 0xe6, 0x8f, 0x89,
+                        0xd6, 0x5c, 0x39, 0x5c, 0xc4, 0xc4 };
+#elif defined(AES192)
+    uint8_t key[48] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t pt[102] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d,
+                        0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7,
+                        0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+                        0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b,
+                        0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t tags[80] = { 0xdf, 0xb6, 0xc5, 0x5b, 0x01, 0xa5, 0x4f, 0x8e, 0x9e, 0x90, 0xcb, 0xcf, 0x63, 0x6c, 0x87, 0x65,
+                         0xf6, 0x5d, 0xb0, 0x6c, 0xdd, 0x68, 0xc1, 0x32, 0x73, 0x09, 0x56, 0xb2, 0x75, 0xaa, 0x8b, 0x9b,
+                         0xf1, 0x01, 0x2a, 0x79, 0x96, 0x26, 0x46, 0x53, 0x99, 0x71, 0x82, 0xa1, 0x98, 0xec, 0x10, 0x6c,
+                         0x53, 0xfc, 0x9c, 0xfa, 0x62, 0x60, 0xe1, 0x85, 0xb7, 0x33, 0xba, 0x96, 0x16, 0x92, 0xf5, 0x48,
+                         0xbe, 0x2c, 0xa2, 0xf8, 0xa8, 0xe4, 0x5f, 0x12, 0x25, 0xba, 0x0d, 0xf3, 0x85, 0x9f, 0x4d, 0xa2 };
+    uint8_t ct[102] = { 0x2d, 0x06, 0xfb, 0xbd, 0x97, 0xe4, 0xf4, 0xc7, 0xd6, 0xcd, 0x70, 0x97, 0xd2, 0x05, 0xe1, 0xda,
+                        0x1d, 0xbd, 0xd8, 0xe6, 0x58, 0x81, 0xf1, 0x4f, 0xff, 0x90, 0x95, 0x6a, 0x5b, 0x2b, 0xd1, 0xfe,
+                        0x60, 0x18, 0xb6, 0x96, 0xe1, 0x30, 0x12, 0x71, 0x0e, 0x0f, 0x4a, 0x15, 0x44, 0x64, 0x58, 0x15,
+                        0x51, 0x48, 0x84, 0x07, 0xc3, 0x05, 0x8c, 0x89, 0x5b, 0xf6, 0x50, 0x6d, 0xd1, 0x77, 0xfe, 0x9e,
+                        0x0b, 0x85, 0xc6, 0x6b, 0x40, 0x91, 0xa7, 0xe6, 0xd5, 0xea, 0x4a, 0xee, 0x60, 0x57, 0x61, 0x29,
+                        0x20, 0xde, 0xd7, 0x37, 0x10, 0x00, 0x0e, 0xe6, 0xfb, 0x4d, 0xa6, 0x37, 0xfe, 0x65, 0x5b, 0x04,
+                        0x0e, 0xdc, 0x20, 0xde, 0xdb, 0xcf };
+#elif defined(AES128)
+    uint8_t key[32] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t pt[102] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+                        0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d,
+                        0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7,
+                        0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb,
+                        0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b,
+                        0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t tags[80] = { 0x55, 0x59, 0x1d, 0xca, 0xc7, 0x55, 0x44, 0xda, 0x25, 0xc7, 0x0d, 0x93, 0x67, 0x29, 0x08, 0x10,
+                         0xcc, 0x1c, 0xd9, 0xb3, 0x16, 0xa0, 0x44, 0x17, 0x24, 0x05, 0x0e, 0xd3, 0x58, 0xeb, 0xce, 0x3e,
+                         0x94, 0x3e, 0x3a, 0xb8, 0x9f, 0x49, 0x0f, 0x30, 0x05, 0x1f, 0x26, 0x79, 0xde, 0x4a, 0x1f, 0x51,
+                         0xee, 0x22, 0x19, 0x6e, 0x66, 0x32, 0xcc, 0xcd, 0x4e, 0x54, 0x4e, 0x42, 0xa4, 0x7d, 0xb1, 0x0a,
+                         0x6d, 0xf6, 0x9d, 0x05, 0x66, 0x0a, 0x88, 0x55, 0x33, 0x12, 0xb1, 0x9a, 0x2e, 0x81, 0x76, 0xca };
+    uint8_t ct[102] = { 0xdf, 0xe6, 0x61, 0x33, 0xbf, 0xea, 0xff, 0xc4, 0xb3, 0x4e, 0xc7, 0x32, 0x39, 0xbc, 0xeb, 0x6b,
+                        0x16, 0xb2, 0xd8, 0xcc, 0x6c, 0xec, 0xa5, 0x96, 0xe6, 0x59, 0xdd, 0xcc, 0x47, 0x43, 0xa6, 0xca,
+                        0xa4, 0xde, 0x8f, 0xa2, 0xe7, 0x8d, 0x1f, 0x4d, 0x3a, 0x31, 0x1a, 0x88, 0xa6, 0xd2, 0x12, 0x14,
+                        0x15, 0x11, 0x49, 0x51, 0xab, 0x13, 0xf6, 0x37, 0xbc, 0x09, 0x3b, 0xd8, 0xf6, 0xcd, 0x70, 0x63,
+                        0xa7, 0x79, 0x86, 0xf3, 0x02, 0x3a, 0xe4, 0x2c, 0x0e, 0x9b, 0x8f, 0x06, 0x2c, 0x93, 0x75, 0xf5,
+                        0x0a, 0x8a, 0x2f, 0xa0, 0x65, 0x90, 0x1d, 0xc3, 0x23, 0x38, 0x26, 0xdd, 0x96, 0x13, 0xab, 0x0a,
+                        0x6b, 0x12, 0x45, 0x33, 0x5f, 0x0a };
+#endif
+    uint8_t in[102];
+    uint8_t* bufs[5] = { in, in, in + 5, in + 21, in + 38 };
+    size_t lengths[5] = { 0, 5, 16, 17, 64 };
+    uint8_t out_tags[80];
+    struct AES_SIV_ctx ctx;
+
+    memcpy(in, pt, 102);
+    AES_SIV_init_ctx(&ctx, key);
+    AES_SIV_encrypt_buffers(&ctx, 0, 0, bufs, lengths, 5, out_tags);
+
+    printf("SIV batch: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 102)) && (0 == memcmp((char*) tags, (char*) out_tags, 80))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_kw(void)
+{
+#if defined(AES256)
+    uint8_t kek[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t wrapped[40] = { 0xe5, 0x2d, 0x03, 0xbd, 0x6d, 0x04, 0x0f, 0xed, 0xa9, 0xdb, 0x83, 0x94, 0xd2, 0xac, 0xdf, 0xe8,
+                            0x60, 0x24, 0xf0, 0x23, 0x2c, 0xa1, 0x2b, 0x60, 0xef, 0xa1, 0x0f, 0xcd, 0x96, 0x78, 0x9c, 0x02,
+                            0x23, 0x27, 0x92, 0x93, 0x92, 0x38, 0xca, 0x80 };
+#elif defined(AES192)
+    uint8_t kek[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t wrapped[40] = { 0x7b, 0xe0, 0x81, 0x58, 0xef, 0x6c, 0x1b, 0xd7, 0x18, 0xa7, 0x47, 0x8f, 0xb9, 0xcc, 0xe4, 0x2c,
+                            0x0f, 0xb3, 0xb0, 0x77, 0x58, 0xbe, 0x50, 0xf3, 0x32, 0x8e, 0x9b, 0xf4, 0x28, 0xb4, 0xb2, 0xed,
+                            0xc6, 0x62, 0x27, 0xc4, 0xaa, 0x60, 0xe6, 0xa8 };
+#elif defined(AES128)
+    uint8_t kek[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t wrapped[40] = { 0xa3, 0x0c, 0x8d, 0xda, 0x93, 0x53, 0xe1, 0xef, 0x44, 0x53, 0x1f, 0x6b, 0xac, 0xce, 0x7f, 0xed,
+                            0xc7, 0xdd, 0x1d, 0x60, 0x13, 0x4d, 0xca, 0xad, 0xea, 0x3e, 0xe1, 0x7c, 0x25, 0xe7, 0x60, 0x36,
+                            0x79, 0x08, 0xc8, 0x8d, 0x78, 0xfe, 0x97, 0x79 };
+#endif
+    uint8_t key[32] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+                        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t out[40];
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, kek);
+    AES_KW_wrap_buffer(&ctx, key, 32, out);
+
+    printf("KW: ");
+
+    // wrapped keys shorter than 3 semiblocks or not a whole number of them must be rejected
+    if ((1 != AES_KW_unwrap_buffer(&ctx, wrapped, 4, out)) || (1 != AES_KW_unwrap_buffer(&ctx, wrapped, 16, out)) ||
+        (1 != AES_KW_unwrap_buffer(&ctx, wrapped, 36, out))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    if ((0 == memcmp((char*) wrapped, (char*) out, 40))
+        && (0 == AES_KW_unwrap_buffer(&ctx, wrapped, 40, out)) && (0 == memcmp((char*) key, (char*) out, 32))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_kwp(void)
+{
+    // RFC 5649 keys of 20 bytes, and of 7 bytes which is wrapped as a single block
+#if defined(AES256)
+    uint8_t kek[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t wrapped20[32] = { 0xd6, 0x18, 0x0a, 0x97, 0xd6, 0xa4, 0x50, 0x81, 0x1a, 0xf8, 0x6d, 0x01, 0xb1, 0x8b, 0x4d, 0x31,
+                              0x8e, 0xbe, 0xf7, 0xdc, 0x7a, 0x90, 0x80, 0x97, 0x54, 0xef, 0x0d, 0xbb, 0xe1, 0x93, 0x92, 0xce };
+    uint8_t wrapped7[16] = { 0xd6, 0x8c, 0xef, 0xb5, 0xa1, 0x13, 0x87, 0x4d, 0x3b, 0xb5, 0x2c, 0xd1, 0xf0, 0x6b, 0xb7, 0x9a };
+#elif defined(AES192)
+    uint8_t kek[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t wrapped20[32] = { 0xa2, 0x97, 0xfd, 0x04, 0xbc, 0xfa, 0x4f, 0xf9, 0xeb, 0x91, 0xd4, 0x96, 0x9d, 0x2d, 0xc0, 0xaf,
+                              0x35, 0x6e, 0x5f, 0x78, 0xe0, 0xbe, 0xca, 0xb4, 0x65, 0xcc, 0x77, 0x9a, 0x17, 0x48, 0x02, 0x1c };
+    uint8_t wrapped7[16] = { 0x59, 0xfc, 0x96, 0xcb, 0xac, 0xa7, 0x90, 0x5f, 0x23, 0x0b, 0xe2, 0xe6, 0x43, 0xaa, 0x92, 0xa5 };
+#elif defined(AES128)
+    uint8_t kek[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t wrapped20[32] = { 0x04, 0xad, 0xe7, 0xfc, 0x9a, 0xa1, 0xcb, 0x0b, 0x5b, 0xfd, 0x69, 0x4f, 0xc2, 0x70, 0x91, 0x24,
+                              0x88, 0x50, 0xb8, 0x44, 0x38, 0x27, 0x63, 0xdd, 0x99, 0xa2, 0xcb, 0x61, 0xa5, 0xa6, 0xc8, 0xb0 };
+    uint8_t wrapped7[16] = { 0x69, 0x58, 0xab, 0x07, 0x10, 0xcb, 0x6c, 0xac, 0xad, 0xf8, 0xf4, 0x3b, 0x12, 0x55, 0x4c, 0xfe };
+#endif
+    uint8_t key20[20] = { 0xc3, 0x7b, 0x7e, 0x64, 0x92, 0x58, 0x43, 0x40, 0xbe, 0xd1, 0x22, 0x07, 0x80, 0x89, 0x41, 0x15,
+                          0x50, 0x68, 0xf7, 0x38 };
+    uint8_t key7[7]   = { 0x46, 0x6f, 0x72, 0x50, 0x61, 0x73, 0x69 };
+    uint8_t out[32];
+    size_t out_len;
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, kek);
+
+    printf("KWP: ");
+
+    AES_KWP_wrap_buffer(&ctx, key20, 20, out);
+    if (0 != memcmp((char*) wrapped20, (char*) out, 32)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    AES_KWP_wrap_buffer(&ctx, key7, 7, out);
+    AES_KWP_wrap_buffer(&ctx, key7, 0, out); // an empty key cannot be wrapped, leaves out unchanged
+    if (0 != memcmp((char*) wrapped7, (char*) out, 16)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    // a modified key must be rejected
+    wrapped20[31] ^= 0x01;
+    if (0 == AES_KWP_unwrap_buffer(&ctx, wrapped20, 32, out, &out_len)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    wrapped20[31] ^= 0x01;
+
+    // as must wrapped keys shorter than 2 semiblocks or not a whole number of them
+    if ((1 != AES_KWP_unwrap_buffer(&ctx, wrapped20, 8, out, &out_len)) ||
+        (1 != AES_KWP_unwrap_buffer(&ctx, wrapped20, 20, out, &out_len)) || (0 != out_len)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    if ((0 == AES_KWP_unwrap_buffer(&ctx, wrapped20, 32, out, &out_len)) && (20 == out_len) && (0 == memcmp((char*) key20, (char*) out, 20))
+        && (0 == AES_KWP_unwrap_buffer(&ctx, wrapped7, 16, out, &out_len)) && (7 == out_len) && (0 == memcmp((char*) key7, (char*) out, 7))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_kw_rewrap(void)
+{
+    // five 24 byte keys wrapped under old_kek, expected under new_kek
+#if defined(AES256)
+    uint8_t old_kek[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                            0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t new_kek[32] = { 0xf4, 0xdf, 0x14, 0x09, 0xa3, 0x10, 0x98, 0x2d, 0xd7, 0x08, 0x61, 0x3b, 0x07, 0x2c, 0x35, 0x1f,
+                            0x81, 0x77, 0x7d, 0x85, 0xf0, 0xae, 0x73, 0x2b, 0xbe, 0x71, 0xca, 0x15, 0x10, 0xeb, 0x3d, 0x60 };
+    uint8_t wrapped[160] = { 0x29, 0x3d, 0xf8, 0xe7, 0xa4, 0xde, 0xe3, 0x8a, 0x5f, 0x58, 0x82, 0x6e, 0xbe, 0x43, 0x22, 0xf2,
+                             0x04, 0xa5, 0xb7, 0x69, 0x1a, 0x3e, 0xce, 0x03, 0xd6, 0xfa, 0x2f, 0xd1, 0xed, 0xec, 0x6b, 0x8d,
+                             0x8a, 0x0c, 0xc1, 0xe4, 0xc8, 0x15, 0xd0, 0x0b, 0xfc, 0x5b, 0x96, 0x91, 0x95, 0x57, 0xc2, 0x0c,
+                             0x63, 0xa7, 0x14, 0xb6, 0x3a, 0x13, 0xa2, 0x41, 0x6b, 0x7d, 0x20, 0xb1, 0xbb, 0x69, 0x39, 0x18,
+                             0xe6, 0xdc, 0xf6, 0xf3, 0x3a, 0x9e, 0x40, 0x36, 0x62, 0x66, 0xea, 0xd7, 0xec, 0xfa, 0xb5, 0xa1,
+                             0x96, 0xfb, 0xd1, 0xa2, 0xaf, 0xbc, 0xfd, 0xe2, 0xbe, 0x8e, 0x0d, 0x51, 0x26, 0x17, 0xd7, 0x15,
+                             0x5e, 0x1f, 0x76, 0x0e, 0x2a, 0x20, 0x35, 0x77, 0x39, 0xbb, 0x8d, 0xdb, 0xfd, 0x87, 0xb2, 0x28,
+                             0x9b, 0x41, 0x27, 0xd0, 0x4c, 0xa5, 0x28, 0xc7, 0x05, 0x21, 0x8c, 0xc8, 0x78, 0x46, 0x45, 0x85,
+                             0xc4, 0x64, 0x11, 0xbc, 0xed, 0x2e, 0x46, 0x57, 0x05, 0x06, 0x35, 0x60, 0x0f, 0x0e, 0x8d, 0xa2,
+                             0x55, 0x56, 0xb4, 0x26, 0xfa, 0xc1, 0x9f, 0x7a, 0xca, 0x62, 0x7f, 0xd3, 0xc1, 0x82, 0xd7, 0x91 };
+#elif defined(AES192)
+    uint8_t old_kek[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                            0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t new_kek[24] = { 0x7b, 0x6b, 0x2c, 0x52, 0xd2, 0xea, 0xf8, 0x62, 0xe5, 0x79, 0x90, 0x80, 0x2b, 0xf3, 0x10, 0xc8,
+                            0x52, 0x64, 0x0e, 0xda, 0xf7, 0xb0, 0x73, 0x8e };
+    uint8_t wrapped[160] = { 0x58, 0x2b, 0xbe, 0x08, 0x64, 0x71, 0x5e, 0x6d, 0x4b, 0xf8, 0xc4, 0xb9, 0xed, 0x8b, 0x63, 0x16,
+                             0x69, 0x60, 0xc9, 0x80, 0xe7, 0x6f, 0x25, 0x8a, 0x0f, 0x81, 0xbe, 0x39, 0x2b, 0xe6, 0x2a, 0xb1,
+                             0x23, 0x5e, 0x7a, 0x6a, 0x4c, 0x4f, 0xc2, 0xb3, 0xfb, 0xce, 0x23, 0x9a, 0x80, 0xfb, 0x5a, 0x6d,
+                             0xda, 0x4e, 0x96, 0x63, 0xe5, 0xf7, 0xee, 0xa6, 0x5b, 0x4f, 0x32, 0x48, 0x20, 0x91, 0xb9, 0x53,
+                             0x4a, 0x5d, 0x4a, 0x4c, 0x3d, 0x22, 0xaa, 0xfa, 0x3f, 0xf3, 0xb4, 0x76, 0x81, 0xa1, 0x58, 0x5a,
+                             0xde, 0x5c, 0x7b, 0xd9, 0x9d, 0x4e, 0x08, 0x4d, 0x25, 0xee, 0xc5, 0x9c, 0x99, 0xdc, 0x36, 0x1f,
+                             0x33, 0x20, 0x2a, 0x1a, 0x8f, 0x83, 0x8a, 0x50, 0x72, 0x8e, 0x97, 0x32, 0xc9, 0xcc, 0x0b, 0x0e,
+                             0xc2, 0x1b, 0x22, 0x93, 0x0a, 0xc5, 0x25, 0x0a, 0x71, 0xf4, 0x31, 0xcb, 0x6b, 0xf5, 0x1d, 0xec,
+                             0x6e, 0x42, 0x15, 0x46, 0x47, 0x0e, 0x98, 0xf8, 0x33, 0x17, 0x85, 0x14, 0xb8, 0xa4, 0xd7, 0xe8,
+                             0x4a, 0xce, 0xe4, 0x81, 0x85, 0xcc, 0xed, 0xdb, 0xe8, 0x3b, 0xf9, 0xcd, 0xf5, 0xe2, 0xa9, 0xc4 };
+#elif defined(AES128)
+    uint8_t old_kek[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t new_kek[16] = { 0x3c, 0x4f, 0xcf, 0x09, 0x88, 0x15, 0xf7, 0xab, 0xa6, 0xd2, 0xae, 0x28, 0x16, 0x15, 0x7e, 0x2b };
+    uint8_t wrapped[160] = { 0x51, 0x69, 0x5d, 0x1b, 0xb4, 0x3d, 0xd8, 0x3d, 0xa7, 0x0f, 0xb6, 0x0a, 0x1b, 0xd2, 0xaa, 0x25,
+                             0xd0, 0x51, 0x19, 0x5e, 0x61, 0x57, 0xdd, 0x83, 0x63, 0x6b, 0xa9, 0x5a, 0x17, 0xb0, 0x3f, 0x33,
+                             0x75, 0x1b, 0xe0, 0x9c, 0x77, 0x06, 0x49, 0x52, 0xf2, 0xcc, 0xa0, 0x97, 0xba, 0x60, 0x97, 0x1e,
+                             0x15, 0xa9, 0x33, 0x0b, 0x52, 0xe0, 0xa3, 0xe1, 0xd7, 0xfb, 0x57, 0x98, 0x61, 0xff, 0x5b, 0x97,
+                             0x9c, 0xf3, 0xa0, 0xa5, 0x2b, 0x25, 0x46, 0x3b, 0x2b, 0xf9, 0xaa, 0x49, 0x2f, 0xee, 0x8e, 0x03,
+                             0xd4, 0xf7, 0xf8, 0x21, 0x66, 0x85, 0xee, 0x48, 0xbe, 0x42, 0x74, 0x2e, 0x23, 0x54, 0x6d, 0xd0,
+                             0x04, 0xa4, 0xe6, 0xf0, 0xc9, 0xfa, 0x86, 0x41, 0x67, 0x4d, 0x8c, 0x02, 0xbd, 0xba, 0xaa, 0x0c,
+                             0xab, 0xb3, 0x0a, 0xba, 0x38, 0x33, 0x93, 0x13, 0x3e, 0x90, 0x4a, 0x02, 0xfd, 0xee, 0x81, 0xa9,
+                             0x85, 0xd3, 0x83, 0xf1, 0xc2, 0xaa, 0x7a, 0xf7, 0xc1, 0xfd, 0xa4, 0x0a, 0xbb, 0x5f, 0x6b, 0x36,
+                             0x56, 0xc9, 0xec, 0x50, 0x71, 0x99, 0x0a, 0xe9, 0xad, 0x70, 0xe6, 0x13, 0xe4, 0xc8, 0xf0, 0x11 };
+#endif
+    uint8_t key[32] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+                        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t bufs[5][32];
+    uint8_t* ptrs[5] = { bufs[0], bufs[1], bufs[2], bufs[3], bufs[4] };
+    size_t lengths[5] = { 32, 32, 32, 32, 32 };
+    struct AES_ctx old_ctx, new_ctx;
+
+    AES_init_ctx(&old_ctx, old_kek);
+    AES_init_ctx(&new_ctx, new_kek);
+    AES_KW_wrap_buffer(&old_ctx, key, 24, bufs[0]);
+    AES_KW_wrap_buffer(&old_ctx, key + 4, 24, bufs[1]);
+    AES_KW_wrap_buffer(&old_ctx, key + 8, 24, bufs[2]);
+    AES_KW_wrap_buffer(&old_ctx, key + 2, 24, bufs[3]);
+    AES_KW_wrap_buffer(&old_ctx, key + 6, 24, bufs[4]);
+
+    printf("KW rewrap: ");
+
+    if ((0 == AES_KW_rewrap_buffers(&old_ctx, &new_ctx, ptrs, lengths, 5)) && (0 == memcmp((char*) wrapped, (char*) bufs, 160))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_eax(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xc8, 0x83, 0xb2, 0xe4, 0x35, 0x09, 0x25, 0x3f, 0x45, 0x09, 0x61, 0xb0, 0x59, 0xea, 0xc1, 0x78,
+                       0x40, 0x2a, 0xab, 0x37, 0xe9, 0x63, 0x3a, 0x30, 0x0d, 0xa7, 0x3a, 0xdd, 0xd3, 0xad, 0x35, 0x6a,
+                       0xe5, 0xbf, 0x25, 0xb3, 0x74, 0xaf, 0x6f, 0x8d, 0x71, 0x99, 0x19, 0xbd, 0x6a, 0xa0, 0x8f, 0xa2,
+                       0x90, 0xda, 0x5e, 0x79, 0x6a, 0x0c, 0x4b, 0x3d, 0x3f, 0x10, 0x45, 0xa7 };
+    uint8_t tag[16] = { 0xbf, 0x7b, 0x74, 0x0d, 0x49, 0x3e, 0x8c, 0x89, 0x20, 0x6a, 0x95, 0x31, 0x2f, 0x5a, 0x22, 0xbc };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x83, 0xe1, 0xd6, 0x48, 0xd7, 0x3a, 0xbb, 0x3d, 0x16, 0x98, 0xa6, 0x13, 0xc1, 0x1b, 0x6d, 0x03,
+                       0x5c, 0xc3, 0x42, 0x38, 0x4a, 0xa5, 0x03, 0x5f, 0xee, 0xba, 0xd0, 0x0d, 0x6c, 0x64, 0xd0, 0x49,
+                       0x08, 0x3b, 0xf4, 0x9d, 0x94, 0xd1, 0xf8, 0x6a, 0x4b, 0x11, 0x00, 0x07, 0x6a, 0xcd, 0x9d, 0x6e,
+                       0xf4, 0x3d, 0xcc, 0x35, 0x29, 0x23, 0x43, 0xda, 0x90, 0xac, 0x05, 0xd8 };
+    uint8_t tag[16] = { 0xfb, 0xcb, 0x65, 0x85, 0xe5, 0x44, 0x7e, 0x2f, 0x4a, 0x9c, 0x1e, 0xb4, 0xb8, 0x65, 0xda, 0x5b };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x43, 0x04, 0xae, 0x00, 0x74, 0xf7, 0x2d, 0x25, 0xe5, 0x04, 0xcc, 0x75, 0xf4, 0x5c, 0x7c, 0x09,
+                       0x98, 0xce, 0xa2, 0x30, 0xee, 0xd3, 0xdf, 0x84, 0x85, 0x33, 0x40, 0x69, 0xed, 0x72, 0xf6, 0x3c,
+                       0x85, 0x95, 0x50, 0x98, 0x67, 0xed, 0x5d, 0x5d, 0xf3, 0xb8, 0x52, 0x68, 0x9d, 0x57, 0x1b, 0x4d,
+                       0x22, 0xda, 0x4b, 0xbf, 0x95, 0xae, 0xd0, 0x08, 0xb4, 0x43, 0x5c, 0x93 };
+    uint8_t tag[16] = { 0x31, 0xd4, 0x8f, 0x18, 0xce, 0x4a, 0xa2, 0x9a, 0x2b, 0xbb, 0x80, 0x41, 0xd8, 0x38, 0xc0, 0x93 };
+#endif
+    uint8_t nonce[13] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0x00 };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t out_tag[16];
+    struct AES_EAX_ctx ctx;
+
+    AES_EAX_init_ctx(&ctx, key);
+    AES_EAX_encrypt_buffer(&ctx, nonce, 13, aad, 20, in, 60, out_tag, 16);
+
+    printf("EAX encrypt: ");
+
+    if ((0 == memcmp((char*) ct, (char*) in, 60)) && (0 == memcmp((char*) tag, (char*) out_tag, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_eax(void)
+{
+    // 7 byte nonce and truncated 8 byte tag
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x1a, 0x20, 0x18, 0x9c, 0xe9, 0xe6, 0x81, 0x8d, 0x89, 0x44, 0x7f, 0xc2, 0xa6, 0x98, 0x46, 0x8d,
+                       0xbf, 0x28, 0x56, 0x4b, 0x0c, 0x31, 0x2d, 0x66, 0x2c, 0x3e, 0x78, 0xd7, 0x5d, 0x45, 0xda, 0xc8,
+                       0x0c, 0xb2, 0x79, 0xe2, 0xb4, 0x66, 0x39, 0x1b, 0x90, 0xd3, 0x77, 0xc2, 0x65, 0xee, 0x70, 0x97,
+                       0x16, 0xc8, 0x21, 0x46, 0xb8, 0xd9, 0x2b, 0x5f, 0x84, 0x60, 0x91, 0xfe };
+    uint8_t tag[8] = { 0x64, 0x88, 0xd8, 0x05, 0x0c, 0xd0, 0xf6, 0xa6 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0xfb, 0x83, 0x95, 0xc3, 0xcd, 0x1a, 0x61, 0x00, 0x70, 0x64, 0x94, 0x8a, 0x57, 0xfb, 0xb7, 0x71,
+                       0x60, 0x52, 0x38, 0xc8, 0x3b, 0x05, 0x45, 0xaa, 0x00, 0x24, 0x46, 0xad, 0x9d, 0x17, 0x29, 0xbd,
+                       0x52, 0xae, 0x89, 0xe8, 0x72, 0xd2, 0x64, 0xb2, 0x24, 0xc2, 0x6f, 0x57, 0xa9, 0xd0, 0xa6, 0xc0,
+                       0xde, 0xf4, 0xb5, 0x91, 0xa0, 0xc6, 0x3c, 0xd7, 0x03, 0x7c, 0x60, 0xba };
+    uint8_t tag[8] = { 0xfd, 0x7a, 0x20, 0x40, 0x70, 0xf5, 0x15, 0xd5 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0xd0, 0x81, 0xa3, 0x58, 0x8a, 0x33, 0x13, 0xd3, 0x7a, 0x83, 0xb0, 0xa8, 0x32, 0x53, 0xb6, 0x1e,
+                       0x71, 0xb8, 0x20, 0x29, 0x80, 0x92, 0x13, 0x27, 0x34, 0x21, 0x4a, 0xa1, 0xdd, 0x71, 0x4d, 0xa8,
+                       0x37, 0x33, 0x7e, 0x0a, 0xf1, 0x80, 0x7c, 0x59, 0x31, 0x69, 0x54, 0xf9, 0x4e, 0xfa, 0x7c, 0x22,
+                       0x21, 0x48, 0x31, 0xae, 0x2a, 0x57, 0x32, 0x36, 0x5d, 0x59, 0x65, 0x4d };
+    uint8_t tag[8] = { 0xd5, 0x20, 0xb5, 0xb6, 0xf7, 0xa3, 0x86, 0x75 };
+#endif
+    uint8_t nonce[7] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t in[60];
+    struct AES_EAX_ctx ctx;
+
+    AES_EAX_init_ctx(&ctx, key);
+
+    printf("EAX decrypt: ");
+
+    // a modified tag must be rejected
+    memcpy(in, ct, 60);
+    tag[7] ^= 0x01;
+    if (0 == AES_EAX_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 8)) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+    tag[7] ^= 0x01;
+
+    // so must an empty or over-long tag
+    memcpy(in, ct, 60);
+    if ((0 == AES_EAX_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 0)) ||
+        (0 == AES_EAX_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 17))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    memcpy(in, ct, 60);
+    if ((0 == AES_EAX_decrypt_buffer(&ctx, nonce, 7, aad, 20, in, 60, tag, 8)) && (0 == memcmp((char*) out, (char*) in, 60))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_drbg(void)
+{
+#if defined(AES256)
+    uint8_t out[64] = { 0x05, 0xee, 0x7c, 0xae, 0xf6, 0x56, 0x30, 0x01, 0xe4, 0x38, 0x90, 0xe8, 0x2b, 0x43, 0x26, 0x9e,
+                        0x30, 0x13, 0x22, 0x3d, 0x42, 0xc6, 0x6d, 0x14, 0x03, 0x43, 0xc2, 0xbb, 0xa4, 0x97, 0xe6, 0x8e,
+                        0x3c, 0x70, 0xd7, 0x5c, 0x10, 0x58, 0x60, 0xc0, 0x3e, 0xfb, 0xa0, 0xa0, 0x8d, 0x50, 0x08, 0x24,
+                        0xd9, 0x5f, 0x32, 0x52, 0x3b, 0x62, 0x72, 0xbe, 0x88, 0x84, 0x19, 0x48, 0xf9, 0xb7, 0xdf, 0x97 };
+#elif defined(AES192)
+    uint8_t out[64] = { 0xc7, 0x77, 0x21, 0x92, 0x3a, 0x50, 0x4f, 0x0b, 0x74, 0x56, 0x1b, 0x31, 0xd7, 0x4c, 0x12, 0xf2,
+                        0x96, 0x84, 0xe0, 0xe8, 0x9f, 0x7e, 0x54, 0x7b, 0xa3, 0x0d, 0x4e, 0x0c, 0x26, 0xc9, 0x30, 0x70,
+                        0xc8, 0xc2, 0xdf, 0xc7, 0x7a, 0x20, 0x83, 0x38, 0x09, 0x50, 0x55, 0x1a, 0x13, 0x6c, 0x58, 0xcd,
+                        0x0a, 0xa4, 0x5a, 0x37, 0xa3, 0x06, 0x56, 0x27, 0x34, 0x33, 0x1b, 0x78, 0x50, 0x86, 0x62, 0xf3 };
+#elif defined(AES128)
+    uint8_t out[64] = { 0x43, 0xeb, 0x32, 0x1a, 0xd3, 0xfb, 0x89, 0x5f, 0xb9, 0xfd, 0x5e, 0xbf, 0x67, 0xac, 0x70, 0x96,
+                        0xde, 0xa1, 0xe3, 0x58, 0xfd, 0x98, 0xc5, 0xe1, 0x9e, 0x54, 0x2c, 0xfd, 0x83, 0xcc, 0x9b, 0x5d,
+                        0xd5, 0x9e, 0xf4, 0xb5, 0x52, 0x27, 0xab, 0x13, 0x5d, 0x68, 0x01, 0xd5, 0xd0, 0x3c, 0x34, 0x65,
+                        0x1c, 0xa8, 0x15, 0x12, 0x32, 0xd0, 0x91, 0xca, 0xe3, 0x40, 0xc9, 0x1b, 0xce, 0xa5, 0x3c, 0x16 };
+#endif
+    uint8_t entropy[32] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f };
+    uint8_t nonce[8] = { 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67 };
+    uint8_t pers[16] = { 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f };
+    uint8_t add[20] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+                        0xb0, 0xb1, 0xb2, 0xb3 };
+    uint8_t buf[64];
+    struct AES_DRBG_ctx ctx;
+
+    AES_DRBG_init_ctx(&ctx, entropy, 32, nonce, 8, pers, 16);
+    AES_DRBG_generate(&ctx, buf, 64, 0, 0);
+    AES_DRBG_generate(&ctx, buf, 64, add, 20);
+
+    printf("CTR_DRBG: ");
+
+    if (0 == memcmp((char*) out, (char*) buf, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_drbg_no_df(void)
+{
+#if defined(AES256)
+    uint8_t entropy[48] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+                            0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f };
+    uint8_t out[64] = { 0x5e, 0xe7, 0xf9, 0x98, 0x3b, 0xe9, 0x3c, 0x29, 0x62, 0x62, 0x2a, 0xa9, 0x1e, 0xfa, 0x94, 0x3f,
+                        0xc8, 0x68, 0xc1, 0x9a, 0xbc, 0x25, 0x2f, 0xa5, 0x65, 0x95, 0x1f, 0x41, 0x5e, 0xaf, 0x59, 0x37,
+                        0xd5, 0x5e, 0xd6, 0xc1, 0xc0, 0xa1, 0xfb, 0x66, 0x7d, 0xef, 0xde, 0x19, 0x30, 0xbb, 0x3b, 0xc3,
+                        0x23, 0xa1, 0xff, 0xd2, 0xf1, 0x93, 0x05, 0x88, 0x74, 0x2c, 0xcb, 0x40, 0xac, 0x52, 0x51, 0x3c };
+#elif defined(AES192)
+    uint8_t entropy[40] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+                            0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+    uint8_t out[64] = { 0x32, 0x1c, 0xd4, 0xd5, 0x10, 0x55, 0x9a, 0x82, 0xc9, 0x69, 0x37, 0xeb, 0x86, 0xf5, 0x5c, 0x21,
+                        0xc9, 0x90, 0x99, 0x80, 0x0b, 0x8e, 0xe8, 0xbd, 0x55, 0x76, 0x3b, 0xc6, 0x27, 0x25, 0xb2, 0xff,
+                        0x05, 0x11, 0x5b, 0x16, 0x1f, 0xde, 0x4c, 0xfc, 0x37, 0x03, 0x4d, 0xcc, 0xe7, 0xec, 0xc4, 0x6f,
+                        0x2a, 0x00, 0x27, 0x19, 0xba, 0x41, 0x01, 0x11, 0x77, 0x04, 0xe7, 0xe1, 0x0c, 0x5f, 0xbf, 0x86 };
+#elif defined(AES128)
+    uint8_t entropy[32] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f };
+    uint8_t out[64] = { 0x4c, 0x39, 0x42, 0x8c, 0x3c, 0x3f, 0x39, 0xf3, 0xa4, 0xa8, 0x7f, 0x5e, 0xae, 0x1e, 0x4a, 0x0b,
+                        0x4c, 0x89, 0x17, 0x0f, 0xd9, 0x0a, 0x18, 0xa2, 0xf9, 0x44, 0xa7, 0xdd, 0x13, 0xc6, 0x14, 0x14,
+                        0x4e, 0x07, 0x39, 0xc3, 0x0b, 0xc9, 0x6e, 0x55, 0xb4, 0x83, 0x5a, 0xe0, 0xe2, 0xe3, 0x03, 0x03,
+                        0xe3, 0x58, 0x9a, 0x9c, 0xf0, 0x18, 0xed, 0x0a, 0xef, 0xa6, 0xe2, 0x6e, 0xeb, 0x57, 0x9c, 0x97 };
+#endif
+    uint8_t pers[16] = { 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f };
+    uint8_t add[20] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+                        0xb0, 0xb1, 0xb2, 0xb3 };
+    uint8_t buf[64];
+    struct AES_DRBG_ctx ctx;
+
+    AES_DRBG_init_ctx_no_df(&ctx, entropy, pers, 16);
+    AES_DRBG_generate(&ctx, buf, 64, add, 20);
+    AES_DRBG_generate(&ctx, buf, 64, 0, 0);
+
+    printf("CTR_DRBG no df: ");
+
+    // without derivation function, inputs longer than the seed are rejected and an unseeded instance generates nothing
+    {
+        uint8_t seeded[sizeof(buf)];
+        struct AES_DRBG_ctx bad;
+
+        memcpy(seeded, buf, sizeof(buf));
+        if ((1 != AES_DRBG_generate(&ctx, buf, 16, out, AES_DRBG_SEEDLEN + 1))
+            || (1 != AES_DRBG_init_ctx_no_df(&bad, entropy, out, AES_DRBG_SEEDLEN + 1))
+            || (1 != AES_DRBG_generate(&bad, buf, 16, 0, 0)) || (0 != memcmp(seeded, buf, sizeof(buf)))) {
+            printf("FAILURE!\n");
+	    return(1);
+        }
+    }
+
+    if (0 == memcmp((char*) out, (char*) buf, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_drbg_reseed(void)
+{
+#if defined(AES256)
+    uint8_t out[64] = { 0x6b, 0x6d, 0x1d, 0x49, 0xe7, 0xee, 0x3c, 0x81, 0x39, 0xde, 0x07, 0x0b, 0x0d, 0x02, 0xa9, 0xc5,
+                        0x17, 0x49, 0x1a, 0x9f, 0x8c, 0x9b, 0x39, 0xd5, 0x88, 0xf6, 0x65, 0x69, 0x01, 0x00, 0x8c, 0x9f,
+                        0x6e, 0x6f, 0xca, 0x6e, 0xb6, 0x4e, 0x2f, 0xf9, 0x48, 0x33, 0x02, 0x39, 0x06, 0x3a, 0x66, 0xd7,
+                        0x06, 0xac, 0x12, 0x8f, 0xb6, 0xea, 0xde, 0xa8, 0x06, 0xa0, 0x68, 0xbe, 0xf2, 0x31, 0x2a, 0xb9 };
+#elif defined(AES192)
+    uint8_t out[64] = { 0xbc, 0x76, 0x07, 0x4d, 0x67, 0x31, 0x37, 0x3e, 0x05, 0xab, 0x91, 0x9f, 0xc5, 0x3b, 0x91, 0xdb,
+                        0xdc, 0x2f, 0x39, 0xb8, 0x65, 0x59, 0x7a, 0xc6, 0xb8, 0xc9, 0xc3, 0xdd, 0x99, 0x72, 0x9b, 0x2b,
+                        0x34, 0x4b, 0x79, 0x6c, 0x4a, 0x31, 0xf5, 0xec, 0x7f, 0x41, 0x34, 0x4a, 0xe8, 0x0f, 0x3e, 0x29,
+                        0xeb, 0xdc, 0x00, 0xad, 0xa9, 0x34, 0x28, 0xa9, 0xdb, 0xdd, 0xca, 0xa7, 0xec, 0x3a, 0xaf, 0x62 };
+#elif defined(AES128)
+    uint8_t out[64] = { 0x50, 0x30, 0x07, 0xbf, 0x1a, 0xdf, 0x81, 0x7b, 0x8d, 0x61, 0x48, 0x94, 0xa4, 0x61, 0xc9, 0x98,
+                        0xcf, 0x8e, 0x38, 0x32, 0x26, 0x12, 0x4e, 0xc8, 0x85, 0x89, 0x6d, 0x0f, 0x32, 0xbf, 0x22, 0x00,
+                        0x5e, 0x1b, 0x79, 0xb3, 0x96, 0xad, 0x62, 0x86, 0x95, 0x48, 0x45, 0x85, 0x80, 0x56, 0xa0, 0xdf,
+                        0x95, 0x24, 0x26, 0xc7, 0xb7, 0x3b, 0x26, 0x86, 0x61, 0x45, 0x54, 0x4d, 0x98, 0x14, 0x72, 0x77 };
+#endif
+    uint8_t entropy[32] = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+                            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f };
+    uint8_t nonce[8] = { 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67 };
+    uint8_t entropy2[32] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+                             0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf };
+    uint8_t add[20] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+                        0xb0, 0xb1, 0xb2, 0xb3 };
+    uint8_t buf[64];
+    struct AES_DRBG_ctx ctx;
+
+    AES_DRBG_init_ctx(&ctx, entropy, 32, nonce, 8, 0, 0);
+    AES_DRBG_generate(&ctx, buf, 64, 0, 0);
+    AES_DRBG_reseed(&ctx, entropy2, 32, add, 20);
+    AES_DRBG_generate(&ctx, buf, 64, 0, 0);
+
+    printf("CTR_DRBG reseed: ");
+
+    if (0 == memcmp((char*) out, (char*) buf, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_ctr_keystream(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t stream[61] = { 0x0b, 0xdf, 0x7d, 0xf1, 0x59, 0x17, 0x16, 0x33, 0x5e, 0x9a, 0x8b, 0x15, 0xc8, 0x60, 0xc5, 0x02,
+                           0x5a, 0x6e, 0x69, 0x9d, 0x53, 0x61, 0x19, 0x06, 0x54, 0x33, 0x86, 0x3c, 0x8f, 0x65, 0x7b, 0x94,
+                           0x1b, 0xc1, 0x2c, 0x9c, 0x01, 0x61, 0x0d, 0x5d, 0x0d, 0x8b, 0xd6, 0xa3, 0x37, 0x8e, 0xca, 0x62,
+                           0x29, 0x56, 0xe1, 0xc8, 0x69, 0x35, 0x36, 0xb1, 0xbe, 0xe9, 0x9c, 0x73, 0xa3 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t stream[61] = { 0x71, 0x7d, 0x2d, 0xc6, 0x39, 0x12, 0x83, 0x34, 0xa6, 0x16, 0x7a, 0x48, 0x8d, 0xed, 0x79, 0x21,
+                           0xa7, 0x2e, 0xb3, 0xbb, 0x14, 0xa5, 0x56, 0x73, 0x4b, 0x7b, 0xad, 0x6a, 0xb1, 0x61, 0x00, 0xc5,
+                           0x2e, 0xfe, 0xae, 0x2d, 0x72, 0xb7, 0x22, 0x61, 0x34, 0x46, 0xdc, 0x7f, 0x4c, 0x2a, 0xf9, 0x18,
+                           0xb9, 0xe7, 0x83, 0xb3, 0x0d, 0xd7, 0x92, 0x4f, 0xf7, 0xbc, 0x9b, 0x97, 0xbe };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t stream[61] = { 0xec, 0x8c, 0xdf, 0x73, 0x98, 0x60, 0x7c, 0xb0, 0xf2, 0xd2, 0x16, 0x75, 0xea, 0x9e, 0xa1, 0xe4,
+                           0x36, 0x2b, 0x7c, 0x3c, 0x67, 0x73, 0x51, 0x63, 0x18, 0xa0, 0x77, 0xd7, 0xfc, 0x50, 0x73, 0xae,
+                           0x6a, 0x2c, 0xc3, 0x78, 0x78, 0x89, 0x37, 0x4f, 0xbe, 0xb4, 0xc8, 0x1b, 0x17, 0xba, 0x6c, 0x44,
+                           0xe8, 0x9c, 0x39, 0x9f, 0xf0, 0xf1, 0x98, 0xc6, 0xd4, 0x0a, 0x31, 0xdb, 0x15 };
+#endif
+    uint8_t iv[16]  = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+    uint8_t out[61];
+    struct AES_ctx ctx;
+
+    // The output is not read, and the Iv continues after the blocks written
+    memset(out, 0xa5, 61);
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_CTR_keystream_buffer(&ctx, out, 32);
+    AES_CTR_keystream_buffer(&ctx, out + 32, 29);
+
+    printf("CTR keystream: ");
+
+    if (0 == memcmp((char *) stream, (char *) out, 61)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_ff1(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t out[19] = { 0x20, 0x0c, 0x19, 0x1f, 0x11, 0x03, 0x07, 0x12, 0x07, 0x1c, 0x20, 0x1c, 0x03, 0x17, 0x16, 0x14,
+                        0x09, 0x00, 0x02 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t out[19] = { 0x1f, 0x0a, 0x21, 0x0c, 0x13, 0x20, 0x06, 0x1c, 0x15, 0x08, 0x11, 0x1d, 0x0f, 0x0a, 0x13, 0x00,
+                        0x1c, 0x03, 0x05 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t out[19] = { 0x0a, 0x09, 0x1d, 0x1f, 0x04, 0x00, 0x16, 0x15, 0x15, 0x09, 0x14, 0x0d, 0x1e, 0x05, 0x00, 0x09,
+                        0x0e, 0x1e, 0x16 };
+#endif
+    uint8_t tweak[11] = { 0x37, 0x37, 0x37, 0x37, 0x70, 0x71, 0x72, 0x73, 0x37, 0x37, 0x37 };
+    uint8_t in[19] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+                       0x10, 0x11, 0x12 };
+    uint8_t big[AES_FPE_MAX_LEN + 1] = { 0 };
+    struct AES_ctx ctx;
+
+    AES_init_ctx(&ctx, key);
+
+    printf("FF1 encrypt: ");
+
+    // radix outside 2 to 256, radix^length below 1000000 or strings longer than AES_FPE_MAX_LEN must be rejected
+    if ((1 != AES_FF1_encrypt_buffer(&ctx, tweak, 11, 1, big, 19)) ||
+        (1 != AES_FF1_encrypt_buffer(&ctx, tweak, 11, 257, in, 19)) || (1 != AES_FF1_encrypt_buffer(&ctx, tweak, 11, 36, in, 3)) ||
+        (1 != AES_FF1_decrypt_buffer(&ctx, tweak, 11, 10, big, AES_FPE_MAX_LEN + 1))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    AES_FF1_encrypt_buffer(&ctx, tweak, 11, 36, in, 19);
+
+    if (0 == memcmp((char*) out, (char*) in, 19)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_ff3(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t out[18] = { 0x03, 0x06, 0x01, 0x05, 0x05, 0x04, 0x06, 0x00, 0x01, 0x03, 0x01, 0x05, 0x03, 0x05, 0x03, 0x09,
+                        0x05, 0x02 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t out[18] = { 0x09, 0x06, 0x06, 0x01, 0x09, 0x09, 0x00, 0x00, 0x02, 0x01, 0x04, 0x05, 0x09, 0x00, 0x07, 0x07,
+                        0x06, 0x07 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t out[18] = { 0x06, 0x02, 0x08, 0x07, 0x04, 0x01, 0x09, 0x04, 0x07, 0x08, 0x01, 0x08, 0x07, 0x01, 0x08, 0x07,
+                        0x02, 0x01 };
+#endif
+    uint8_t tweak[7] = { 0xd8, 0xe7, 0x92, 0x0a, 0xfa, 0x33, 0x0a };
+    uint8_t in[18] = { 0x08, 0x09, 0x00, 0x01, 0x02, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x00, 0x00,
+                       0x00, 0x00 };
+    uint8_t big[57] = { 0 };
+    struct AES_ctx ctx;
+
+    AES_FF3_init_ctx(&ctx, key);
+
+    printf("FF3-1 encrypt: ");
+
+    // tweaks other than 7 bytes and decimal strings longer than 56 digits must be rejected
+    if ((1 != AES_FF3_encrypt_buffer(&ctx, tweak, 8, 10, in, 18)) ||
+        (0 != AES_FF3_decrypt_buffer(&ctx, tweak, 7, 10, big, 56)) || (1 != AES_FF3_decrypt_buffer(&ctx, tweak, 7, 10, big, 57))) {
+        printf("FAILURE!\n");
+	return(1);
+    }
+
+    AES_FF3_encrypt_buffer(&ctx, tweak, 7, 10, in, 18);
+
+    if (0 == memcmp((char*) out, (char*) in, 18)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_ff1_buffers(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t in0[16] = { 0x01, 0x01, 0x05, 0x03, 0x00, 0x01, 0x08, 0x01, 0x01, 0x05, 0x02, 0x09, 0x03, 0x05, 0x05, 0x02 };
+    uint8_t in1[10] = { 0x04, 0x08, 0x05, 0x00, 0x06, 0x00, 0x00, 0x03, 0x07, 0x09 };
+    uint8_t in2[20] = { 0x04, 0x09, 0x03, 0x09, 0x08, 0x08, 0x09, 0x05, 0x03, 0x04, 0x06, 0x01, 0x05, 0x03, 0x05, 0x01,
+                        0x07, 0x05, 0x02, 0x04 };
+    uint8_t in3[6] = { 0x02, 0x08, 0x07, 0x09, 0x06, 0x06 };
+    uint8_t in4[17] = { 0x09, 0x04, 0x01, 0x04, 0x03, 0x01, 0x04, 0x05, 0x07, 0x00, 0x00, 0x07, 0x08, 0x09, 0x01, 0x00,
+                        0x09 };
+    uint8_t in5[26] = { 0x09, 0x01, 0x09, 0x08, 0x08, 0x09, 0x06, 0x09, 0x09, 0x05, 0x04, 0x02, 0x02, 0x00, 0x05, 0x06,
+                        0x03, 0x03, 0x08, 0x03, 0x09, 0x09, 0x03, 0x03, 0x07, 0x00 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t in0[16] = { 0x05, 0x00, 0x07, 0x09, 0x07, 0x04, 0x06, 0x09, 0x00, 0x02, 0x04, 0x03, 0x05, 0x01, 0x01, 0x02 };
+    uint8_t in1[10] = { 0x02, 0x09, 0x09, 0x09, 0x08, 0x05, 0x01, 0x03, 0x08, 0x05 };
+    uint8_t in2[20] = { 0x09, 0x03, 0x07, 0x04, 0x04, 0x09, 0x04, 0x05, 0x01, 0x02, 0x06, 0x09, 0x00, 0x05, 0x01, 0x04,
+                        0x09, 0x00, 0x03, 0x07 };
+    uint8_t in3[6] = { 0x03, 0x09, 0x08, 0x03, 0x09, 0x04 };
+    uint8_t in4[17] = { 0x06, 0x03, 0x05, 0x00, 0x04, 0x08, 0x06, 0x03, 0x05, 0x04, 0x09, 0x01, 0x05, 0x08, 0x01, 0x01,
+                        0x09 };
+    uint8_t in5[26] = { 0x04, 0x09, 0x02, 0x03, 0x09, 0x09, 0x06, 0x06, 0x03, 0x03, 0x00, 0x06, 0x02, 0x08, 0x02, 0x06,
+                        0x09, 0x00, 0x09, 0x08, 0x00, 0x05, 0x00, 0x08, 0x02, 0x07 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t in0[16] = { 0x06, 0x04, 0x02, 0x03, 0x01, 0x01, 0x05, 0x09, 0x09, 0x01, 0x06, 0x06, 0x09, 0x07, 0x04, 0x03 };
+    uint8_t in1[10] = { 0x02, 0x04, 0x03, 0x03, 0x04, 0x07, 0x07, 0x04, 0x08, 0x04 };
+    uint8_t in2[20] = { 0x00, 0x00, 0x08, 0x01, 0x04, 0x05, 0x08, 0x05, 0x06, 0x08, 0x09, 0x05, 0x04, 0x04, 0x08, 0x08,
+                        0x02, 0x06, 0x01, 0x04 };
+    uint8_t in3[6] = { 0x07, 0x01, 0x09, 0x01, 0x01, 0x03 };
+    uint8_t in4[17] = { 0x08, 0x01, 0x01, 0x09, 0x05, 0x03, 0x08, 0x08, 0x07, 0x00, 0x04, 0x07, 0x00, 0x09, 0x05, 0x07,
+                        0x08 };
+    uint8_t in5[26] = { 0x04, 0x04, 0x06, 0x04, 0x09, 0x01, 0x00, 0x01, 0x06, 0x08, 0x09, 0x02, 0x03, 0x07, 0x09, 0x03,
+                        0x09, 0x06, 0x05, 0x02, 0x08, 0x06, 0x03, 0x04, 0x04, 0x05 };
+#endif
+    uint8_t out0[16] = { 0x04, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x01, 0x02, 0x03, 0x04, 0x01, 0x02, 0x03, 0x04 };
+    uint8_t out1[10] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+    uint8_t out2[20] = { 0x09, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00, 0x09, 0x08, 0x07, 0x06, 0x05, 0x04,
+                         0x03, 0x02, 0x01, 0x00 };
+    uint8_t out3[6] = { 0x05, 0x05, 0x05, 0x05, 0x05, 0x05 };
+    uint8_t out4[17] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                         0x07 };
+    uint8_t out5[26] = { 0x03, 0x01, 0x04, 0x01, 0x05, 0x09, 0x02, 0x06, 0x05, 0x03, 0x05, 0x08, 0x09, 0x07, 0x09, 0x03,
+                         0x02, 0x03, 0x08, 0x04, 0x06, 0x02, 0x06, 0x04, 0x03, 0x03 };
+    uint8_t* bufs[6] = { in0, in1, in2, in3, in4, in5 };
+    size_t lengths[6] = { 16, 10, 20, 6, 17, 26 };
+    int fail = 0;
+    size_t i;
+    struct AES_ctx ctx;
+
+    // Values of different lengths, decrypted in one batch
+    AES_init_ctx(&ctx, key);
+    AES_FF1_decrypt_buffers(&ctx, 0, 0, 10, bufs, lengths, 6);
+    fail |= memcmp(in0, out0, lengths[0]) | memcmp(in1, out1, lengths[1]) | memcmp(in2, out2, lengths[2]);
+    fail |= memcmp(in3, out3, lengths[3]) | memcmp(in4, out4, lengths[4]) | memcmp(in5, out5, lengths[5]);
+
+    // and encrypted back
+    AES_FF1_encrypt_buffers(&ctx, 0, 0, 10, bufs, lengths, 6);
+    for (i = 0; i < 6; ++i)
+    {
+        AES_FF1_decrypt_buffer(&ctx, 0, 0, 10, bufs[i], lengths[i]);
+    }
+    fail |= memcmp(in0, out0, lengths[0]) | memcmp(in1, out1, lengths[1]) | memcmp(in2, out2, lengths[2]);
+    fail |= memcmp(in3, out3, lengths[3]) | memcmp(in4, out4, lengths[4]) | memcmp(in5, out5, lengths[5]);
+
+    printf("FF1 batch: ");
+
+    if (0 == fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cbc_pkcs7(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[64] = { 0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+                       0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+                       0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+                       0x3c, 0x24, 0x7a, 0x56, 0x23, 0x7c, 0x13, 0x5b, 0x75, 0x7c, 0x11, 0xfd, 0x34, 0xd5, 0xef, 0x70 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[64] = { 0x4f, 0x02, 0x1d, 0xb2, 0x43, 0xbc, 0x63, 0x3d, 0x71, 0x78, 0x18, 0x3a, 0x9f, 0xa0, 0x71, 0xe8,
+                       0xb4, 0xd9, 0xad, 0xa9, 0xad, 0x7d, 0xed, 0xf4, 0xe5, 0xe7, 0x38, 0x76, 0x3f, 0x69, 0x14, 0x5a,
+                       0x57, 0x1b, 0x24, 0x20, 0x12, 0xfb, 0x7a, 0xe0, 0x7f, 0xa9, 0xba, 0xac, 0x3d, 0xf1, 0x02, 0xe0,
+                       0x28, 0xb1, 0x67, 0x8b, 0x97, 0x3c, 0x75, 0x02, 0xbe, 0xcf, 0x58, 0x6b, 0xc6, 0x3f, 0xbf, 0x11 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[64] = { 0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+                       0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+                       0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+                       0x2c, 0x50, 0x9b, 0xd3, 0x96, 0x14, 0x8c, 0x7c, 0xe2, 0x05, 0x97, 0x8a, 0xba, 0xe9, 0xee, 0x61 };
+#endif
+    uint8_t iv[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t in[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                       0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                       0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                       0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t buf[64];
+    size_t length, out_len;
+    struct AES_ctx ctx;
+    int fail;
+
+    memcpy(buf, in, 60);
+    AES_init_ctx_iv(&ctx, key, iv);
+    length = AES_CBC_PKCS7_encrypt_buffer(&ctx, buf, 60);
+    fail = (length != 64) || memcmp(ct, buf, 64);
+
+    AES_ctx_set_iv(&ctx, iv);
+    fail |= AES_CBC_PKCS7_decrypt_buffer(&ctx, buf, 64, &out_len) || (out_len != 60) || memcmp(in, buf, 60);
+
+    // A flipped bit in the second-to-last block turns the padding 04 04 04 04 into 04 04 04 05
+    memcpy(buf, ct, 64);
+    buf[47] ^= 1;
+    AES_ctx_set_iv(&ctx, iv);
+    fail |= (AES_CBC_PKCS7_decrypt_buffer(&ctx, buf, 64, &out_len) != 1);
+
+    // Lengths that are not a whole number of blocks are rejected before decrypting
+    memcpy(buf, ct, 64);
+    AES_ctx_set_iv(&ctx, iv);
+    fail |= (AES_CBC_PKCS7_decrypt_buffer(&ctx, buf, 60, &out_len) != 1) || (out_len != 0);
+    AES_ctx_set_iv(&ctx, iv);
+    fail |= (AES_CBC_PKCS7_decrypt_buffer(&ctx, buf, 0, &out_len) != 1);
+
+    printf("CBC PKCS#7: ");
+
+    if (0 == fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_cbc_cs3(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+                       0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+                       0x5d, 0xb5, 0x5a, 0x7b, 0x8a, 0x98, 0x43, 0xbc, 0x11, 0x2b, 0xfb, 0xeb, 0x4c, 0xf6, 0x56, 0x5f,
+                       0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x4f, 0x02, 0x1d, 0xb2, 0x43, 0xbc, 0x63, 0x3d, 0x71, 0x78, 0x18, 0x3a, 0x9f, 0xa0, 0x71, 0xe8,
+                       0xb4, 0xd9, 0xad, 0xa9, 0xad, 0x7d, 0xed, 0xf4, 0xe5, 0xe7, 0x38, 0x76, 0x3f, 0x69, 0x14, 0x5a,
+                       0xdb, 0x2d, 0xe6, 0xce, 0xab, 0x1f, 0x23, 0x0d, 0x74, 0xb5, 0x40, 0xe9, 0xc4, 0x50, 0x1f, 0x66,
+                       0x57, 0x1b, 0x24, 0x20, 0x12, 0xfb, 0x7a, 0xe0, 0x7f, 0xa9, 0xba, 0xac };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+                       0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+                       0x58, 0x53, 0x40, 0xb2, 0xff, 0x11, 0xa6, 0xa5, 0x51, 0x29, 0x9d, 0x32, 0xa1, 0x3d, 0x78, 0xb0,
+                       0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e };
+#endif
+    uint8_t iv[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t in[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                       0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                       0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                       0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_CBC_CS3_encrypt_buffer(&ctx, in, 15); // too short, leaves buf and Iv unchanged
+    AES_CBC_CS3_encrypt_buffer(&ctx, in, 60);
+
+    printf("CBC-CS3 encrypt: ");
+
+    if (0 == memcmp((char*) ct, (char*) in, 60)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_cbc_cs3(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+                       0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+                       0x5d, 0xb5, 0x5a, 0x7b, 0x8a, 0x98, 0x43, 0xbc, 0x11, 0x2b, 0xfb, 0xeb, 0x4c, 0xf6, 0x56, 0x5f,
+                       0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x4f, 0x02, 0x1d, 0xb2, 0x43, 0xbc, 0x63, 0x3d, 0x71, 0x78, 0x18, 0x3a, 0x9f, 0xa0, 0x71, 0xe8,
+                       0xb4, 0xd9, 0xad, 0xa9, 0xad, 0x7d, 0xed, 0xf4, 0xe5, 0xe7, 0x38, 0x76, 0x3f, 0x69, 0x14, 0x5a,
+                       0xdb, 0x2d, 0xe6, 0xce, 0xab, 0x1f, 0x23, 0x0d, 0x74, 0xb5, 0x40, 0xe9, 0xc4, 0x50, 0x1f, 0x66,
+                       0x57, 0x1b, 0x24, 0x20, 0x12, 0xfb, 0x7a, 0xe0, 0x7f, 0xa9, 0xba, 0xac };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+                       0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+                       0x58, 0x53, 0x40, 0xb2, 0xff, 0x11, 0xa6, 0xa5, 0x51, 0x29, 0x9d, 0x32, 0xa1, 0x3d, 0x78, 0xb0,
+                       0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e };
+#endif
+    uint8_t iv[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_ctx ctx;
+
+    AES_init_ctx_iv(&ctx, key, iv);
+    AES_CBC_CS3_decrypt_buffer(&ctx, ct, 60);
+
+    printf("CBC-CS3 decrypt: ");
+
+    if (0 == memcmp((char*) out, (char*) ct, 60)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_gmac(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t tag[16] = { 0x4d, 0xfe, 0x69, 0xc3, 0x21, 0x64, 0x64, 0x17, 0x2e, 0x6c, 0x14, 0x16, 0x93, 0x7e, 0x76, 0xd2 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t tag[16] = { 0x77, 0x25, 0x2d, 0x86, 0xf7, 0xb0, 0x73, 0xb1, 0x89, 0x09, 0x12, 0x55, 0xd7, 0xef, 0xdd, 0x38 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t tag[16] = { 0xd3, 0x93, 0x0e, 0x4a, 0xd1, 0xec, 0x34, 0x97, 0x49, 0x6f, 0x12, 0x9a, 0x22, 0xcd, 0x7b, 0xb0 };
+#endif
+    uint8_t iv[12]  = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88 };
+    uint8_t in[64]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t out_tag[16];
+    struct AES_GCM_ctx ctx;
+
+    AES_GCM_init_ctx(&ctx, key);
+    AES_GMAC_buffer(&ctx, iv, 12, in, 64, out_tag, 16);
+
+    printf("GMAC: ");
+
+    if (0 == memcmp((char*) tag, (char*) out_tag, 16)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_gmac_stream(void)
+{
+    // 64 bit IV, data fed in pieces straddling block boundaries
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t tag[16] = { 0x10, 0x9b, 0x0e, 0x21, 0xf7, 0x51, 0xe7, 0xa4, 0x6c, 0x6d, 0x41, 0x32, 0x7b, 0x50, 0xc9, 0x4c };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t tag[16] = { 0xba, 0xc4, 0xfb, 0x54, 0xb0, 0x5d, 0x1e, 0xe4, 0x8e, 0xac, 0xf6, 0x2f, 0x3e, 0xc9, 0xb9, 0x2d };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t tag[16] = { 0x38, 0x85, 0x9b, 0x3a, 0x7e, 0x7a, 0xd8, 0x92, 0x1b, 0x66, 0xe6, 0x6b, 0xbc, 0x7f, 0x72, 0x55 };
+#endif
+    uint8_t iv[8]   = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad };
+    uint8_t in[64]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t out_tag[16];
+    struct AES_GCM_ctx ctx;
+    struct AES_GMAC_ctx gmac;
+    int fail;
+
+    AES_GCM_init_ctx(&ctx, key);
+    AES_GMAC_init(&gmac, &ctx, iv, 8);
+    AES_GMAC_update(&gmac, in, 5);
+    AES_GMAC_update(&gmac, in + 5, 0);
+    AES_GMAC_update(&gmac, in + 5, 30);
+    AES_GMAC_update(&gmac, in + 35, 29);
+    AES_GMAC_final(&gmac, out_tag, 16);
+    fail = memcmp((char*) tag, (char*) out_tag, 16) != 0;
+
+    AES_GMAC_init(&gmac, &ctx, iv, 8);
+    AES_GMAC_update(&gmac, in, 64);
+    fail |= AES_GMAC_verify(&gmac, tag, 16) != 0;
+
+    // a flipped tag bit must be rejected
+    tag[7] ^= 0x01;
+    AES_GMAC_init(&gmac, &ctx, iv, 8);
+    AES_GMAC_update(&gmac, in, 64);
+    fail |= AES_GMAC_verify(&gmac, tag, 16) != 1;
+
+    // as must an empty tag, an over-long tag and an empty IV
+    tag[7] ^= 0x01;
+    AES_GMAC_init(&gmac, &ctx, iv, 8);
+    AES_GMAC_update(&gmac, in, 64);
+    fail |= AES_GMAC_verify(&gmac, tag, 0) != 1;
+    fail |= AES_GMAC_verify(&gmac, tag, 17) != 1;
+    AES_GMAC_init(&gmac, &ctx, iv, 0);
+    AES_GMAC_update(&gmac, in, 64);
+    fail |= AES_GMAC_verify(&gmac, tag, 16) != 1;
+
+    printf("GMAC stream: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cmac_kdf(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t okm[40] = { 0x14, 0x9f, 0xad, 0x02, 0xda, 0xdb, 0x4b, 0x38, 0x59, 0x74, 0x1f, 0x0a, 0xc5, 0xa6, 0x7c, 0x99,
+                        0x03, 0xbf, 0x62, 0x1d, 0xe4, 0x08, 0x43, 0xb9, 0xcd, 0x42, 0xcc, 0xce, 0xc5, 0x16, 0x38, 0x94,
+                        0x82, 0x7f, 0xa5, 0x35, 0x7c, 0x84, 0xb3, 0xc9 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t okm[40] = { 0x8a, 0xe8, 0x3f, 0xa3, 0x8f, 0xcb, 0xeb, 0x46, 0x8b, 0xa5, 0x93, 0x1d, 0xf1, 0x7e, 0xcb, 0x41,
+                        0x7a, 0x39, 0xe9, 0x8b, 0xb2, 0x0c, 0xb2, 0xe8, 0x93, 0xbf, 0xb6, 0xff, 0x05, 0xad, 0x2c, 0x61,
+                        0xc3, 0xb7, 0x1b, 0x77, 0xae, 0x3d, 0x98, 0x6c };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t okm[40] = { 0xba, 0xe7, 0x7b, 0xeb, 0x0a, 0x5e, 0x90, 0xaa, 0x70, 0x46, 0x95, 0xf8, 0x5d, 0xcc, 0x86, 0x31,
+                        0x7c, 0x60, 0x01, 0x43, 0x35, 0xc7, 0x16, 0x68, 0x26, 0x8f, 0x10, 0xfb, 0x43, 0xbb, 0xf3, 0xba,
+                        0x82, 0xfb, 0xf5, 0x98, 0xdb, 0x7a, 0x37, 0x66 };
+#endif
+    uint8_t msg[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    uint8_t out[40];
+    struct AES_CMAC_ctx ctx;
+
+    // label msg[0..12), context msg[12..40)
+    AES_CMAC_init_ctx(&ctx, key);
+    AES_CMAC_KDF_buffer(&ctx, msg, 12, msg + 12, 28, out, 40);
+
+    printf("CMAC KDF: ");
+
+    if (0 == memcmp((char*) okm, (char*) out, 40)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cmac_kdf_buffers(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t okm[100] = { 0x41, 0xf6, 0x86, 0xfb, 0x5d, 0xf3, 0x87, 0x68, 0xb8, 0xef, 0xb9, 0xff, 0x2e, 0xd9, 0x85, 0xf9,
+                         0x05, 0x41, 0x89, 0xe7, 0x37, 0xb2, 0x39, 0x7a, 0xc5, 0xd6, 0x12, 0x5a, 0x08, 0xc2, 0x55, 0xe5,
+                         0xa9, 0x6e, 0xc7, 0x90, 0xf8, 0x84, 0x81, 0xc1, 0xe8, 0x7e, 0x7e, 0x6c, 0xd1, 0xc4, 0xd1, 0xa2,
+                         0xf5, 0xb2, 0xec, 0x01, 0x35, 0x43, 0x09, 0xdb, 0x09, 0xea, 0xa9, 0xdf, 0x5d, 0x3b, 0x44, 0x90,
+                         0x80, 0x07, 0xd6, 0xb1, 0xa5, 0xf8, 0x52, 0x37, 0x35, 0xaf, 0x73, 0x3c, 0xb3, 0x15, 0xe4, 0x57,
+                         0xc7, 0x98, 0xcd, 0x2a, 0xa4, 0x77, 0xc7, 0x36, 0xcb, 0xfc, 0x61, 0xc5, 0x2f, 0x50, 0x65, 0x05,
+                         0xa5, 0x17, 0x6a, 0x7d };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t okm[100] = { 0xd3, 0xfe, 0x6e, 0xb9, 0xd6, 0x13, 0x22, 0x90, 0xff, 0x93, 0x51, 0x48, 0xd6, 0x03, 0x0a, 0xf0,
+                         0xcb, 0xc7, 0x13, 0xab, 0xf7, 0xc6, 0x5d, 0x3c, 0x96, 0x07, 0x4b, 0x95, 0xeb, 0x64, 0x13, 0xbd,
+                         0x59, 0x87, 0xf3, 0xc7, 0xb0, 0x8d, 0xcc, 0x46, 0x67, 0x26, 0xc1, 0x7b, 0x42, 0x4a, 0xe7, 0x53,
+                         0x34, 0x13, 0x25, 0x87, 0xb0, 0x58, 0x8b, 0x3b, 0xbb, 0xec, 0xb0, 0x94, 0xcb, 0xf7, 0x96, 0x1f,
+                         0xa5, 0x0f, 0x7c, 0x2f, 0xbc, 0x3c, 0x97, 0x7b, 0x4c, 0x79, 0xaa, 0x5d, 0x37, 0x48, 0x8b, 0x48,
+                         0xf4, 0xfc, 0xee, 0x3e, 0x86, 0x36, 0x84, 0xc0, 0x8f, 0xec, 0x4e, 0x07, 0x32, 0xcc, 0x0a, 0x12,
+                         0xfb, 0x52, 0xbc, 0x5f };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t okm[100] = { 0x4d, 0x2d, 0xd6, 0x9c, 0xd3, 0x40, 0x8a, 0x7a, 0x5d, 0x1a, 0xcb, 0x4e, 0x80, 0xda, 0xfd, 0xf0,
+                         0xbc, 0xa4, 0x8b, 0xcd, 0x6c, 0xad, 0xc9, 0x76, 0x5c, 0xbe, 0x52, 0x4b, 0x34, 0x9f, 0x71, 0x87,
+                         0x90, 0x41, 0xae, 0x33, 0xa6, 0x41, 0x7d, 0xab, 0xa7, 0x39, 0xaa, 0x48, 0x39, 0x72, 0x0c, 0xb8,
+                         0x04, 0xe4, 0xee, 0x3f, 0x16, 0x5e, 0xa2, 0xdc, 0x22, 0xeb, 0xe5, 0x3a, 0x4a, 0x88, 0x04, 0x60,
+                         0x9a, 0x51, 0x55, 0x3a, 0x89, 0xb9, 0xb6, 0x46, 0x98, 0x05, 0x8b, 0x8e, 0xaf, 0x15, 0x3b, 0x2d,
+                         0xff, 0x15, 0x65, 0x78, 0xac, 0xc5, 0x46, 0x7a, 0x12, 0xb3, 0xb5, 0x94, 0x41, 0xb5, 0x06, 0x8c,
+                         0x3d, 0x20, 0x3b, 0x11 };
+#endif
+    uint8_t msg[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    const uint8_t* labels[5] = { msg, msg + 4, msg, msg + 20, msg + 1 };
+    size_t label_lens[5] = { 4, 16, 0, 3, 40 };
+    const uint8_t* contexts[5] = { msg + 32, msg + 40, msg, msg + 23, msg + 50 };
+    size_t context_lens[5] = { 8, 0, 0, 41, 14 };
+    uint8_t out[100];
+    struct AES_CMAC_ctx ctx;
+
+    AES_CMAC_init_ctx(&ctx, key);
+    AES_CMAC_KDF_buffers(&ctx, labels, label_lens, contexts, context_lens, 5, out, 20);
+
+    printf("CMAC KDF batch: ");
+
+    if (0 == memcmp((char*) okm, (char*) out, 100)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_mmo(void)
+{
+    // Zigbee specification C.5, the same for every key size as AES-MMO always runs AES-128
+    uint8_t digest1[16] = { 0xae, 0x3a, 0x10, 0x2a, 0x28, 0xd4, 0x3e, 0xe0, 0xd4, 0xa0, 0x9e, 0x22, 0x78, 0x8b, 0x20, 0x6c };
+    uint8_t digest2[16] = { 0xa7, 0x97, 0x7e, 0x88, 0xbc, 0x0b, 0x61, 0xe8, 0x21, 0x08, 0x27, 0x10, 0x9a, 0x22, 0x8f, 0x2d };
+    uint8_t msg[16]     = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+    uint8_t out1[16], out2[16];
+
+    AES_MMO_hash(msg, 1, out1);
+    AES_MMO_hash(msg, 16, out2);
+
+    printf("MMO: ");
+
+    if ((0 == memcmp((char*) digest1, (char*) out1, 16)) && (0 == memcmp((char*) digest2, (char*) out2, 16))) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_mmo_hashes(void)
+{
+    // Messages of bytes 0, 1, 2, ... 255, 0, 1, ... The first two take the long padding (Zigbee C.5.4 and C.5.3).
+    uint8_t digests[96] = { 0xdc, 0x6b, 0x06, 0x87, 0xf0, 0x9f, 0x86, 0x07, 0x13, 0x1c, 0x17, 0x0b, 0x3b, 0xd3, 0x15, 0x91,
+                            0x24, 0xec, 0x2f, 0xe7, 0x5b, 0xbf, 0xfc, 0xb3, 0x47, 0x89, 0xbc, 0x06, 0x10, 0xe7, 0xf1, 0x65,
+                            0xba, 0xd7, 0x8e, 0x72, 0x6c, 0x1e, 0xc0, 0x2b, 0x7e, 0xbf, 0xe9, 0x2b, 0x23, 0xd9, 0xec, 0x34,
+                            0x3e, 0xf0, 0x2c, 0x34, 0x4c, 0xb8, 0x36, 0xf7, 0x6a, 0xbc, 0xfa, 0xcd, 0xc8, 0x0c, 0x5e, 0xd4,
+                            0xd2, 0xd9, 0x87, 0xaf, 0x39, 0x2a, 0x74, 0xaa, 0x23, 0x50, 0xbe, 0x20, 0x25, 0x3b, 0x9e, 0x18,
+                            0x05, 0x6b, 0x4e, 0x4a, 0xe1, 0xcd, 0xc8, 0xd0, 0xdb, 0x12, 0x6a, 0x3d, 0x87, 0x09, 0x49, 0xdd };
+    static uint8_t msg[8192];
+    const uint8_t* msgs[6] = { msg, msg, msg, msg, msg, msg };
+    size_t lengths[6] = { 8192, 8191, 0, 13, 14, 40 };
+    uint8_t out[96];
+    size_t i;
+
+    for (i = 0; i < sizeof(msg); ++i)
+    {
+        msg[i] = (uint8_t)i;
+    }
+    AES_MMO_hashes(msgs, lengths, 6, out);
+
+    printf("MMO batch: ");
+
+    if (0 == memcmp((char*) digests, (char*) out, 96)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_rounds(void)
+{
+    // FIPS-197 appendix B, AES-128 run round by round on the expanded key of appendix A.1
+    uint8_t round_keys[176] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+                                0xa0, 0xfa, 0xfe, 0x17, 0x88, 0x54, 0x2c, 0xb1, 0x23, 0xa3, 0x39, 0x39, 0x2a, 0x6c, 0x76, 0x05,
+                                0xf2, 0xc2, 0x95, 0xf2, 0x7a, 0x96, 0xb9, 0x43, 0x59, 0x35, 0x80, 0x7a, 0x73, 0x59, 0xf6, 0x7f,
+                                0x3d, 0x80, 0x47, 0x7d, 0x47, 0x16, 0xfe, 0x3e, 0x1e, 0x23, 0x7e, 0x44, 0x6d, 0x7a, 0x88, 0x3b,
+                                0xef, 0x44, 0xa5, 0x41, 0xa8, 0x52, 0x5b, 0x7f, 0xb6, 0x71, 0x25, 0x3b, 0xdb, 0x0b, 0xad, 0x00,
+                                0xd4, 0xd1, 0xc6, 0xf8, 0x7c, 0x83, 0x9d, 0x87, 0xca, 0xf2, 0xb8, 0xbc, 0x11, 0xf9, 0x15, 0xbc,
+                                0x6d, 0x88, 0xa3, 0x7a, 0x11, 0x0b, 0x3e, 0xfd, 0xdb, 0xf9, 0x86, 0x41, 0xca, 0x00, 0x93, 0xfd,
+                                0x4e, 0x54, 0xf7, 0x0e, 0x5f, 0x5f, 0xc9, 0xf3, 0x84, 0xa6, 0x4f, 0xb2, 0x4e, 0xa6, 0xdc, 0x4f,
+                                0xea, 0xd2, 0x73, 0x21, 0xb5, 0x8d, 0xba, 0xd2, 0x31, 0x2b, 0xf5, 0x60, 0x7f, 0x8d, 0x29, 0x2f,
+                                0xac, 0x77, 0x66, 0xf3, 0x19, 0xfa, 0xdc, 0x21, 0x28, 0xd1, 0x29, 0x41, 0x57, 0x5c, 0x00, 0x6e,
+                                0xd0, 0x14, 0xf9, 0xa8, 0xc9, 0xee, 0x25, 0x89, 0xe1, 0x3f, 0x0c, 0xc8, 0xb6, 0x63, 0x0c, 0xa6 };    uint8_t in[16]  = { 0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d, 0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34 };
+    uint8_t out[16] = { 0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb, 0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32 };
+    uint8_t buf[16], dk[16];
+    uint8_t i, r;
+    int fail;
+
+    for (i = 0; i < 16; ++i)
+    {
+        buf[i] = in[i] ^ round_keys[i];
+    }
+    for (r = 1; r < 10; ++r)
+    {
+        AES_encrypt_round(buf, round_keys + 16 * r);
+    }
+    AES_encrypt_last_round(buf, round_keys + 160);
+    fail = memcmp((char*) out, (char*) buf, 16) != 0;
+
+    // The equivalent inverse cipher, the middle round keys passed through InvMixColumns
+    for (i = 0; i < 16; ++i)
+    {
+        buf[i] ^= round_keys[160 + i];
+    }
+    for (r = 9; r > 0; --r)
+    {
+        memcpy(dk, round_keys + 16 * r, 16);
+        AES_inv_mix_columns(dk);
+        AES_decrypt_round(buf, dk);
+    }
+    AES_decrypt_last_round(buf, round_keys);
+    fail |= memcmp((char*) in, (char*) buf, 16) != 0;
+
+    printf("AES rounds: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_aegis128l(void)
+{
+    // The first test vector of draft-irtf-cfrg-aegis-aead with a 16 byte tag, then a 32 byte tag with associated data.
+    // AEGIS has its own key size, so these are the same for every AES key size.
+    uint8_t tv_key[16] = { 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_nonce[16] = { 0x10, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_in[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_ct[16] = { 0xc1, 0xc0, 0xe5, 0x8b, 0xd9, 0x13, 0x00, 0x6f, 0xeb, 0xa0, 0x0f, 0x4b, 0x3c, 0xc3, 0x59, 0x4e };
+    uint8_t tv_tag[16] = { 0xab, 0xe0, 0xec, 0xe8, 0x0c, 0x24, 0x86, 0x8a, 0x22, 0x6a, 0x35, 0xd1, 0x6b, 0xda, 0xe3, 0x7a };
+    uint8_t key[16] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t nonce[16] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe };
+    uint8_t ct[60] = { 0x6f, 0xb2, 0xb1, 0xe5, 0xcb, 0x2d, 0x03, 0x92, 0x61, 0xe2, 0x17, 0xaf, 0x69, 0xc2, 0x73, 0xe6,
+                       0x28, 0xa3, 0x1b, 0x16, 0x42, 0xdd, 0x0b, 0x9b, 0x25, 0xf1, 0x79, 0x04, 0xe6, 0x95, 0x53, 0x59,
+                       0x5d, 0xbf, 0x48, 0xee, 0x60, 0x67, 0xc4, 0x0f, 0x3a, 0xf0, 0x5d, 0x3c, 0x98, 0x6c, 0xa4, 0x02,
+                       0x8f, 0xad, 0x61, 0x76, 0x7e, 0x44, 0xc1, 0x6e, 0xaf, 0x10, 0x0c, 0x19 };
+    uint8_t tag[32] = { 0x4c, 0xc1, 0x7a, 0x36, 0x94, 0x36, 0x01, 0x7a, 0x37, 0xe4, 0xb7, 0x49, 0x0a, 0x9b, 0x6e, 0x79,
+                        0x13, 0xe6, 0x1d, 0x9e, 0x40, 0x6e, 0x3f, 0x65, 0x34, 0xa7, 0x7f, 0xb3, 0x26, 0x4a, 0xd0, 0x4f };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out_tag[32];
+    int fail;
+
+    AES_AEGIS128L_encrypt_buffer(tv_key, tv_nonce, 0, 0, tv_in, 16, out_tag, 16);
+    fail = (0 != memcmp((char*) tv_ct, (char*) tv_in, 16)) || (0 != memcmp((char*) tv_tag, (char*) out_tag, 16));
+
+    AES_AEGIS128L_encrypt_buffer(key, nonce, aad, 20, in, 60, out_tag, 32);
+    fail |= (0 != memcmp((char*) ct, (char*) in, 60)) || (0 != memcmp((char*) tag, (char*) out_tag, 32));
+
+    printf("AEGIS-128L encrypt: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_aegis128l(void)
+{
+    uint8_t key[16] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81 };
+    uint8_t nonce[16] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe };
+    uint8_t ct[60] = { 0x6f, 0xb2, 0xb1, 0xe5, 0xcb, 0x2d, 0x03, 0x92, 0x61, 0xe2, 0x17, 0xaf, 0x69, 0xc2, 0x73, 0xe6,
+                       0x28, 0xa3, 0x1b, 0x16, 0x42, 0xdd, 0x0b, 0x9b, 0x25, 0xf1, 0x79, 0x04, 0xe6, 0x95, 0x53, 0x59,
+                       0x5d, 0xbf, 0x48, 0xee, 0x60, 0x67, 0xc4, 0x0f, 0x3a, 0xf0, 0x5d, 0x3c, 0x98, 0x6c, 0xa4, 0x02,
+                       0x8f, 0xad, 0x61, 0x76, 0x7e, 0x44, 0xc1, 0x6e, 0xaf, 0x10, 0x0c, 0x19 };
+    uint8_t tag[32] = { 0x4c, 0xc1, 0x7a, 0x36, 0x94, 0x36, 0x01, 0x7a, 0x37, 0xe4, 0xb7, 0x49, 0x0a, 0x9b, 0x6e, 0x79,
+                        0x13, 0xe6, 0x1d, 0x9e, 0x40, 0x6e, 0x3f, 0x65, 0x34, 0xa7, 0x7f, 0xb3, 0x26, 0x4a, 0xd0, 0x4f };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t zeros[60] = { 0 };
+    uint8_t buf[60];
+    int fail;
+
+    memcpy(buf, ct, 60);
+    fail = AES_AEGIS128L_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 32) != 0;
+    fail |= 0 != memcmp((char*) out, (char*) buf, 60);
+
+    // A modified ciphertext must be rejected and the output wiped
+    memcpy(buf, ct, 60);
+    buf[59] ^= 0x80;
+    fail |= AES_AEGIS128L_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 32) != 1;
+    fail |= 0 != memcmp((char*) zeros, (char*) buf, 60);
+
+    // Tag lengths other than 16 and 32 are rejected
+    memcpy(buf, ct, 60);
+    fail |= AES_AEGIS128L_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 0) != 1;
+    fail |= AES_AEGIS128L_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 20) != 1;
+
+    printf("AEGIS-128L decrypt: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_aegis256(void)
+{
+    // The first test vector of draft-irtf-cfrg-aegis-aead with a 16 byte tag, then a 32 byte tag with associated data.
+    // AEGIS has its own key size, so these are the same for every AES key size.
+    uint8_t tv_key[32] = { 0x10, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_nonce[32] = { 0x10, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                             0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_in[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    uint8_t tv_ct[16] = { 0x75, 0x4f, 0xc3, 0xd8, 0xc9, 0x73, 0x24, 0x6d, 0xcc, 0x6d, 0x74, 0x14, 0x12, 0xa4, 0xb2, 0x36 };
+    uint8_t tv_tag[16] = { 0x3f, 0xe9, 0x19, 0x94, 0x76, 0x8b, 0x33, 0x2e, 0xd7, 0xf5, 0x70, 0xa1, 0x9e, 0xc5, 0x89, 0x6e };
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t nonce[32] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe,
+                          0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad };
+    uint8_t ct[60] = { 0x00, 0xb5, 0xfa, 0x8d, 0xb1, 0x9d, 0x3e, 0xef, 0x17, 0xcb, 0xfe, 0xaf, 0x19, 0xb7, 0x95, 0x44,
+                       0x15, 0x2f, 0x01, 0x50, 0xf6, 0x15, 0xc6, 0x73, 0x59, 0x55, 0x16, 0xe0, 0x77, 0x32, 0x4f, 0x19,
+                       0x84, 0xdd, 0x22, 0x82, 0x2c, 0x12, 0x0e, 0x1a, 0x5e, 0x6f, 0x0d, 0x18, 0x82, 0x98, 0xab, 0x07,
+                       0xaf, 0xd9, 0x36, 0x5e, 0x45, 0xa6, 0xea, 0xc8, 0x66, 0x60, 0x71, 0x18 };
+    uint8_t tag[32] = { 0xec, 0x8f, 0x3b, 0x01, 0x0b, 0x39, 0xeb, 0x1b, 0x49, 0x99, 0xd8, 0x1f, 0x07, 0xc6, 0xc6, 0x33,
+                        0x43, 0x01, 0xd1, 0xcc, 0x0b, 0xc1, 0x68, 0x91, 0xac, 0xa7, 0x27, 0x34, 0xc4, 0xc4, 0x0c, 0x55 };
+    uint8_t in[60]  = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t out_tag[32];
+    int fail;
+
+    AES_AEGIS256_encrypt_buffer(tv_key, tv_nonce, 0, 0, tv_in, 16, out_tag, 16);
+    fail = (0 != memcmp((char*) tv_ct, (char*) tv_in, 16)) || (0 != memcmp((char*) tv_tag, (char*) out_tag, 16));
+
+    AES_AEGIS256_encrypt_buffer(key, nonce, aad, 20, in, 60, out_tag, 32);
+    fail |= (0 != memcmp((char*) ct, (char*) in, 60)) || (0 != memcmp((char*) tag, (char*) out_tag, 32));
+
+    printf("AEGIS-256 encrypt: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_aegis256(void)
+{
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t nonce[32] = { 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe,
+                          0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad };
+    uint8_t ct[60] = { 0x00, 0xb5, 0xfa, 0x8d, 0xb1, 0x9d, 0x3e, 0xef, 0x17, 0xcb, 0xfe, 0xaf, 0x19, 0xb7, 0x95, 0x44,
+                       0x15, 0x2f, 0x01, 0x50, 0xf6, 0x15, 0xc6, 0x73, 0x59, 0x55, 0x16, 0xe0, 0x77, 0x32, 0x4f, 0x19,
+                       0x84, 0xdd, 0x22, 0x82, 0x2c, 0x12, 0x0e, 0x1a, 0x5e, 0x6f, 0x0d, 0x18, 0x82, 0x98, 0xab, 0x07,
+                       0xaf, 0xd9, 0x36, 0x5e, 0x45, 0xa6, 0xea, 0xc8, 0x66, 0x60, 0x71, 0x18 };
+    uint8_t tag[32] = { 0xec, 0x8f, 0x3b, 0x01, 0x0b, 0x39, 0xeb, 0x1b, 0x49, 0x99, 0xd8, 0x1f, 0x07, 0xc6, 0xc6, 0x33,
+                        0x43, 0x01, 0xd1, 0xcc, 0x0b, 0xc1, 0x68, 0x91, 0xac, 0xa7, 0x27, 0x34, 0xc4, 0xc4, 0x0c, 0x55 };
+    uint8_t out[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    uint8_t aad[20] = { 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+                        0xab, 0xad, 0xda, 0xd2 };
+    uint8_t zeros[60] = { 0 };
+    uint8_t buf[60];
+    int fail;
+
+    memcpy(buf, ct, 60);
+    fail = AES_AEGIS256_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 32) != 0;
+    fail |= 0 != memcmp((char*) out, (char*) buf, 60);
+
+    // A modified ciphertext must be rejected and the output wiped
+    memcpy(buf, ct, 60);
+    buf[59] ^= 0x80;
+    fail |= AES_AEGIS256_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 32) != 1;
+    fail |= 0 != memcmp((char*) zeros, (char*) buf, 60);
+
+    // Tag lengths other than 16 and 32 are rejected
+    memcpy(buf, ct, 60);
+    fail |= AES_AEGIS256_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 0) != 1;
+    fail |= AES_AEGIS256_decrypt_buffer(key, nonce, aad, 20, buf, 60, tag, 20) != 1;
+
+    printf("AEGIS-256 decrypt: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_haraka256(void)
+{
+    // The test vector of the Haraka v2 paper, input bytes 0, 1, 2, ... It runs no AES key schedule, so it is the same for every key size.
+    uint8_t digest[32] = { 0x80, 0x27, 0xcc, 0xb8, 0x79, 0x49, 0x77, 0x4b, 0x78, 0xd0, 0x54, 0x5f, 0xb7, 0x2b, 0xf7, 0x0c,
+                           0x69, 0x5c, 0x2a, 0x09, 0x23, 0xcb, 0xd4, 0x7b, 0xba, 0x11, 0x59, 0xef, 0xbf, 0x2b, 0x2c, 0x1c };
+    uint8_t in[32];
+    uint8_t out[32];
+    uint8_t i;
+
+    for (i = 0; i < 32; ++i)
+    {
+        in[i] = i;
+    }
+    AES_Haraka256_hash(in, out);
+
+    printf("Haraka-256: ");
+
+    if (0 == memcmp((char*) digest, (char*) out, 32)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_haraka512(void)
+{
+    // The test vector of the Haraka v2 paper, input bytes 0, 1, 2, ... It runs no AES key schedule, so it is the same for every key size.
+    uint8_t digest[32] = { 0xbe, 0x7f, 0x72, 0x3b, 0x4e, 0x80, 0xa9, 0x98, 0x13, 0xb2, 0x92, 0x28, 0x7f, 0x30, 0x6f, 0x62,
+                           0x5a, 0x6d, 0x57, 0x33, 0x1c, 0xae, 0x5f, 0x34, 0xdd, 0x92, 0x77, 0xb0, 0x94, 0x5b, 0xe2, 0xaa };
+    uint8_t in[64];
+    uint8_t out[32];
+    uint8_t i;
+
+    for (i = 0; i < 64; ++i)
+    {
+        in[i] = i;
+    }
+    AES_Haraka512_hash(in, out);
+
+    printf("Haraka-512: ");
+
+    if (0 == memcmp((char*) digest, (char*) out, 32)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_haraka_hashes(void)
+{
+    // Five inputs each, one more than the default AES_LANES, with input bytes 1, 4, 7, ...
+    uint8_t digests256[160] = { 0xf4, 0x54, 0x56, 0x67, 0x7b, 0x63, 0xe3, 0xb9, 0x7e, 0x65, 0x99, 0x43, 0x63, 0x60, 0x5c, 0xda,
+                                0xc2, 0x95, 0x92, 0x2b, 0x75, 0x15, 0x75, 0xf9, 0xb6, 0x7b, 0x0e, 0xa2, 0x2d, 0x63, 0x31, 0x76,
+                                0x43, 0xe3, 0xc3, 0x38, 0x95, 0x19, 0x88, 0xcb, 0x00, 0xad, 0xb7, 0x93, 0x5d, 0x36, 0x14, 0x32,
+                                0x98, 0xee, 0x6c, 0xfe, 0xab, 0x90, 0x0b, 0x9e, 0xa1, 0x2a, 0x81, 0xe5, 0xb5, 0x66, 0xee, 0x0d,
+                                0xcd, 0xcd, 0xc4, 0x00, 0x48, 0x9c, 0xce, 0x7e, 0x4a, 0xfd, 0x66, 0x61, 0xa5, 0xdc, 0xe6, 0x4f,
+                                0xb4, 0x7f, 0xc3, 0xa5, 0x5b, 0x99, 0x50, 0x21, 0xe0, 0x08, 0x5a, 0x75, 0x15, 0x9b, 0x33, 0x97,
+                                0x85, 0x99, 0xad, 0x18, 0x4e, 0xd2, 0x4f, 0xbe, 0xce, 0xb8, 0xf1, 0xe3, 0x23, 0xa2, 0xf3, 0x83,
+                                0x23, 0xd4, 0x69, 0xe8, 0xb0, 0x53, 0x88, 0xd0, 0xc0, 0xbb, 0x8b, 0xf2, 0x54, 0xc9, 0x9f, 0xe4,
+                                0xb7, 0x60, 0xe2, 0xcf, 0xbf, 0x7e, 0x60, 0xf2, 0x32, 0x38, 0xd0, 0xe3, 0x07, 0xda, 0x41, 0xb3,
+                                0x7a, 0x59, 0x9c, 0xd1, 0xdc, 0x5e, 0x5e, 0x14, 0xb7, 0xa9, 0x82, 0x9b, 0xb1, 0x4a, 0x70, 0x2f };
+    uint8_t digests512[160] = { 0x50, 0x94, 0x55, 0xae, 0xad, 0x79, 0x8b, 0x96, 0x84, 0x63, 0x38, 0xf4, 0x04, 0xe7, 0x78, 0x17,
+                                0xa3, 0x2b, 0x8e, 0xf1, 0xce, 0xb4, 0x9d, 0xa3, 0x32, 0xe1, 0xbc, 0x73, 0xf4, 0x47, 0x6b, 0xf0,
+                                0x7b, 0x67, 0xb6, 0xf1, 0x02, 0x54, 0xf0, 0x4a, 0x71, 0x38, 0x99, 0xad, 0x07, 0x2f, 0x42, 0x18,
+                                0x17, 0xb1, 0xd1, 0x3b, 0x4e, 0xfa, 0x34, 0x5c, 0x2d, 0xf3, 0xf7, 0x95, 0xb6, 0xac, 0x9c, 0x5b,
+                                0x23, 0x10, 0xd0, 0x13, 0x8c, 0x1f, 0x4e, 0xbf, 0x4c, 0xd7, 0xbd, 0x61, 0x09, 0xf4, 0xe1, 0x96,
+                                0x7d, 0x8a, 0x0c, 0x44, 0xf1, 0x90, 0x1d, 0x67, 0x14, 0x02, 0x71, 0x95, 0xed, 0x63, 0xb1, 0x87,
+                                0x47, 0x30, 0xaa, 0xaa, 0xe6, 0x1b, 0xe7, 0x40, 0xa3, 0x85, 0xf6, 0x4d, 0xca, 0xc4, 0x04, 0x0a,
+                                0x8e, 0x26, 0x8b, 0x6a, 0xc6, 0xd6, 0x4f, 0xa0, 0xc4, 0x48, 0xbe, 0xf1, 0xa7, 0xb8, 0x98, 0xda,
+                                0x50, 0x94, 0x55, 0xae, 0xad, 0x79, 0x8b, 0x96, 0x84, 0x63, 0x38, 0xf4, 0x04, 0xe7, 0x78, 0x17,
+                                0xa3, 0x2b, 0x8e, 0xf1, 0xce, 0xb4, 0x9d, 0xa3, 0x32, 0xe1, 0xbc, 0x73, 0xf4, 0x47, 0x6b, 0xf0 };
+    uint8_t in[320];
+    uint8_t out[160];
+    size_t i;
+    int fail;
+
+    for (i = 0; i < 320; ++i)
+    {
+        in[i] = (uint8_t)(3 * i + 1);
+    }
+    AES_Haraka256_hashes(in, out, 5);
+    fail = 0 != memcmp((char*) digests256, (char*) out, 160);
+    AES_Haraka512_hashes(in, out, 5);
+    fail |= 0 != memcmp((char*) digests512, (char*) out, 160);
+
+    printf("Haraka batch: ");
+
+    if (!fail) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_cr_hashes(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t hashes[80] = { 0x3e, 0x9c, 0x38, 0x60, 0x99, 0x7c, 0xdc, 0xc8, 0xc9, 0xd9, 0xd7, 0x1a, 0xa9, 0x3d, 0xf8, 0x81,
+                           0x88, 0x75, 0x55, 0x79, 0xa7, 0x9b, 0x70, 0x63, 0x35, 0x1f, 0x27, 0x34, 0x1d, 0x1e, 0x11, 0x80,
+                           0x7d, 0xaa, 0x60, 0x86, 0x45, 0xeb, 0x1f, 0x63, 0xc1, 0x96, 0xa2, 0xfa, 0x4e, 0xa1, 0xf2, 0xf1,
+                           0x1c, 0xc5, 0x0b, 0xae, 0xae, 0xda, 0x41, 0x1e, 0x2b, 0x43, 0x58, 0xb9, 0xab, 0xad, 0x67, 0xfc,
+                           0xf0, 0x4f, 0x8b, 0x10, 0x21, 0x8f, 0x51, 0xab, 0xee, 0xc6, 0xe5, 0x97, 0xf3, 0x14, 0xde, 0x1c };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t hashes[80] = { 0x1c, 0x23, 0x1d, 0x41, 0x21, 0x2c, 0x4b, 0xc8, 0x92, 0x11, 0x91, 0xed, 0x15, 0xc0, 0xfe, 0xc4,
+                           0x48, 0x9d, 0xaa, 0x13, 0x34, 0xd9, 0xd0, 0xa9, 0x9a, 0x10, 0x9b, 0x03, 0xe0, 0xbb, 0xbb, 0xdd,
+                           0x9e, 0xef, 0x3d, 0xdd, 0xb1, 0x48, 0x4b, 0x4f, 0xa5, 0xd9, 0xfb, 0xe4, 0x79, 0x2d, 0xbd, 0x3f,
+                           0x81, 0xb1, 0x72, 0xe3, 0x94, 0xb0, 0x7b, 0x34, 0x95, 0x96, 0x4f, 0x2f, 0x9d, 0x72, 0x1b, 0x57,
+                           0xe1, 0x8e, 0xed, 0xe6, 0xc9, 0x19, 0xd4, 0xaf, 0xa0, 0x0e, 0xcc, 0x0f, 0xa0, 0x6e, 0x5c, 0x6e };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t hashes[80] = { 0xa0, 0x60, 0x37, 0x90, 0xd3, 0x01, 0x1a, 0xc4, 0x1d, 0xf4, 0xa9, 0x8f, 0x15, 0xa8, 0x93, 0xf7,
+                           0x3f, 0x5d, 0xab, 0x1e, 0x8e, 0x11, 0x45, 0x03, 0xa3, 0x38, 0xb7, 0x85, 0xc1, 0xfc, 0x46, 0xff,
+                           0x40, 0x79, 0x92, 0xb5, 0xe3, 0xf6, 0x39, 0x1c, 0x17, 0xa4, 0xdc, 0x99, 0x8e, 0x70, 0xff, 0x51,
+                           0xab, 0x79, 0x13, 0x54, 0x52, 0x92, 0x06, 0xb3, 0xfd, 0x7a, 0x55, 0x7f, 0x18, 0xda, 0x14, 0x84,
+                           0xe8, 0x41, 0xeb, 0xac, 0xbe, 0xdf, 0xbd, 0x6f, 0xd7, 0x5b, 0x47, 0x86, 0x3e, 0x6a, 0x83, 0xa1 };
+#endif
+    uint8_t labels[80] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                           0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                           0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                           0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+                           0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a };
+    uint8_t tweaks[80] = { 0 };
+    uint8_t out[80];
+    struct AES_ctx ctx;
+    size_t i;
+
+    // Tweaks 1, 2, ... 5, as gate indices
+    for (i = 0; i < 5; ++i)
+    {
+        tweaks[i * 16 + 15] = (uint8_t)(i + 1);
+    }
+    AES_init_ctx(&ctx, key);
+    AES_CR_hashes(&ctx, labels, tweaks, out, 5);
+
+    printf("CR hash: ");
+
+    if (0 == memcmp((char*) hashes, (char*) out, 80)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_ccr_hashes(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t hashes[80] = { 0xf7, 0xf7, 0x6d, 0xbe, 0xbc, 0xc2, 0x70, 0xaf, 0x84, 0x80, 0x8b, 0xd3, 0xac, 0x51, 0x2d, 0x0e,
+                           0xe0, 0x6d, 0xdc, 0xcc, 0x5d, 0x29, 0x39, 0x74, 0xc7, 0x7f, 0x11, 0xec, 0x7a, 0x8b, 0xd7, 0xf1,
+                           0x49, 0x97, 0x63, 0xb2, 0xdf, 0xf3, 0x10, 0x82, 0xb0, 0xb7, 0x4d, 0x40, 0x99, 0x86, 0xc9, 0x5f,
+                           0xe4, 0xd3, 0x67, 0x83, 0x2a, 0x34, 0x51, 0x08, 0x7f, 0xc7, 0x2b, 0xc2, 0x8d, 0x0e, 0x92, 0xef,
+                           0xf7, 0xf7, 0x6d, 0xbe, 0xbc, 0xc2, 0x70, 0xaf, 0x84, 0x80, 0x8b, 0xd3, 0xac, 0x51, 0x2d, 0x0e };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t hashes[80] = { 0x55, 0x47, 0x09, 0xc7, 0xf8, 0x93, 0x70, 0xbf, 0xec, 0x6a, 0xc8, 0x77, 0x5c, 0x72, 0xf7, 0x3d,
+                           0x7e, 0xea, 0x6d, 0x16, 0x25, 0xab, 0x45, 0xf3, 0x4a, 0x96, 0x21, 0xbd, 0x28, 0x03, 0x3e, 0x18,
+                           0x35, 0xf2, 0x60, 0xe1, 0x16, 0xd1, 0x74, 0x10, 0x01, 0x9a, 0x4e, 0xda, 0xf3, 0xd7, 0xd5, 0xed,
+                           0x2a, 0x4b, 0x89, 0x6b, 0x51, 0x26, 0xf4, 0x75, 0x0b, 0x7b, 0xa6, 0x56, 0x1e, 0x2c, 0x7b, 0x6f,
+                           0x55, 0x47, 0x09, 0xc7, 0xf8, 0x93, 0x70, 0xbf, 0xec, 0x6a, 0xc8, 0x77, 0x5c, 0x72, 0xf7, 0x3d };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t hashes[80] = { 0x94, 0x99, 0x25, 0x6c, 0x52, 0xdf, 0x51, 0x03, 0xad, 0x34, 0x1d, 0x87, 0xde, 0x68, 0x48, 0xc4,
+                           0x95, 0x71, 0x65, 0xfa, 0xcc, 0x6d, 0x63, 0xf1, 0x31, 0xde, 0xb2, 0xa1, 0x55, 0xa9, 0xfc, 0x89,
+                           0xd4, 0xac, 0x61, 0x7d, 0x02, 0x58, 0x41, 0x53, 0xc5, 0xbe, 0x83, 0x17, 0xa6, 0x9d, 0xfe, 0x51,
+                           0x3d, 0xc0, 0xa4, 0x8f, 0x0f, 0xd1, 0x76, 0x78, 0x80, 0x1c, 0x52, 0xe8, 0x52, 0xd4, 0xd2, 0x46,
+                           0x94, 0x99, 0x25, 0x6c, 0x52, 0xdf, 0x51, 0x03, 0xad, 0x34, 0x1d, 0x87, 0xde, 0x68, 0x48, 0xc4 };
+#endif
+    uint8_t labels[80] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                           0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                           0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                           0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+                           0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a };
+    struct AES_ctx ctx;
+
+    // No tweaks, hashing in place
+    AES_init_ctx(&ctx, key);
+    AES_CCR_hashes(&ctx, labels, NULL, labels, 5);
+
+    printf("CCR hash: ");
+
+    if (0 == memcmp((char*) hashes, (char*) labels, 80)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_encrypt_hctr2(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[60] = { 0x75, 0xfc, 0x56, 0x7e, 0x93, 0xbc, 0xad, 0x5f, 0x2c, 0x62, 0x28, 0xcb, 0x89, 0xea, 0xf1, 0xa5,
+                       0xbe, 0x5d, 0x7e, 0xe1, 0xe8, 0x74, 0x38, 0x8f, 0xa5, 0x98, 0x3e, 0xf4, 0x48, 0x17, 0x7e, 0xb1,
+                       0xcd, 0xf3, 0xe9, 0x9f, 0x50, 0x63, 0xe2, 0xad, 0x02, 0x23, 0xa1, 0xfe, 0xc6, 0xde, 0x74, 0x34,
+                       0x07, 0x37, 0xed, 0x03, 0xcc, 0xbb, 0xe8, 0x67, 0xb9, 0x69, 0x01, 0xa6 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[60] = { 0x38, 0x61, 0x6e, 0x20, 0xfb, 0xa7, 0x83, 0x7a, 0xc9, 0x5a, 0x7e, 0x9e, 0xcc, 0xe7, 0x59, 0x71,
+                       0x81, 0xce, 0x5d, 0x3b, 0xc5, 0xde, 0xf8, 0xaa, 0x8e, 0xee, 0xf3, 0xaa, 0x2d, 0x87, 0x29, 0x72,
+                       0x6c, 0x9a, 0x0e, 0x08, 0x93, 0x49, 0x1a, 0xf8, 0x4a, 0x57, 0xc9, 0xd2, 0x49, 0xb4, 0x24, 0x3c,
+                       0x3e, 0x77, 0xbe, 0xc0, 0x3a, 0x4f, 0x1b, 0x66, 0x1a, 0x17, 0x7c, 0x45 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[60] = { 0x33, 0x80, 0xbb, 0x12, 0x74, 0x3d, 0x25, 0x8f, 0x3e, 0x6a, 0x24, 0x82, 0x35, 0x7c, 0x34, 0x29,
+                       0x00, 0xde, 0x6f, 0xa1, 0x7b, 0xa6, 0xd8, 0x24, 0xdf, 0xc5, 0x6a, 0xb3, 0xfb, 0xcd, 0x22, 0x57,
+                       0x90, 0x27, 0x07, 0x7b, 0x03, 0x5e, 0x05, 0x4c, 0xdc, 0xb7, 0x59, 0xac, 0x09, 0xef, 0x30, 0x49,
+                       0x57, 0x30, 0x0a, 0x56, 0x57, 0x24, 0xf0, 0x91, 0x81, 0x46, 0x82, 0x6f };
+#endif
+    uint8_t tweak[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    uint8_t in[60] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                       0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                       0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                       0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b };
+    struct AES_HCTR2_ctx ctx;
+
+    AES_HCTR2_init_ctx(&ctx, key);
+    AES_HCTR2_encrypt_buffer(&ctx, tweak, 16, in, 15); // too short, leaves buf unchanged
+    AES_HCTR2_encrypt_buffer(&ctx, tweak, 16, in, 60);
+
+    printf("HCTR2 encrypt: ");
+
+    if (0 == memcmp((char*) ct, (char*) in, 60)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}
+
+static int test_decrypt_hctr2(void)
+{
+#if defined(AES256)
+    uint8_t key[32] = { 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+    uint8_t ct[64] = { 0xa7, 0xf0, 0xb0, 0xd7, 0x06, 0x36, 0x63, 0xda, 0x87, 0x80, 0x72, 0x97, 0x06, 0xbe, 0x20, 0x6e,
+                       0x6f, 0x2c, 0x47, 0x06, 0xf4, 0xe3, 0x56, 0x99, 0x52, 0x3f, 0xca, 0xb1, 0x9f, 0x0a, 0x12, 0xe7,
+                       0x0b, 0xcf, 0x93, 0x11, 0x6d, 0x15, 0xb8, 0x4e, 0x86, 0xad, 0xae, 0x11, 0x46, 0x1b, 0xf3, 0xc0,
+                       0x38, 0xa4, 0x89, 0x26, 0x27, 0x8d, 0xed, 0x8e, 0xcb, 0x73, 0x1f, 0xd2, 0x01, 0xbe, 0xd8, 0x01 };
+#elif defined(AES192)
+    uint8_t key[24] = { 0x8e, 0x73, 0xb0, 0xf7, 0xda, 0x0e, 0x64, 0x52, 0xc8, 0x10, 0xf3, 0x2b, 0x80, 0x90, 0x79, 0xe5,
+                        0x62, 0xf8, 0xea, 0xd2, 0x52, 0x2c, 0x6b, 0x7b };
+    uint8_t ct[64] = { 0x55, 0x93, 0x41, 0x50, 0xb7, 0x09, 0x6f, 0x4b, 0x97, 0x2c, 0x43, 0x93, 0x1d, 0xde, 0xab, 0x2a,
+                       0x7c, 0x16, 0xf8, 0x6b, 0xaf, 0x4a, 0xdb, 0x57, 0xcf, 0x1e, 0x0b, 0x4f, 0x4e, 0x62, 0xf2, 0xfe,
+                       0x14, 0x3f, 0x08, 0x9a, 0xec, 0xf8, 0x99, 0xd4, 0x74, 0x4a, 0xe2, 0x24, 0x93, 0xac, 0xaf, 0x51,
+                       0xdb, 0x8d, 0xa5, 0xc4, 0x62, 0xff, 0x57, 0xf9, 0x1b, 0x56, 0x63, 0x4f, 0xb2, 0xd0, 0xfe, 0x00 };
+#elif defined(AES128)
+    uint8_t key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t ct[64] = { 0x39, 0xba, 0x80, 0xa1, 0x7a, 0x2d, 0xcb, 0x81, 0xb8, 0xdf, 0x7e, 0x15, 0x1a, 0x09, 0xf9, 0x28,
+                       0xaf, 0x3b, 0xca, 0x35, 0x55, 0x58, 0xcd, 0x75, 0x6e, 0x66, 0x2a, 0xdd, 0x48, 0xfc, 0x71, 0x4c,
+                       0xb2, 0xd6, 0x12, 0xdd, 0xfd, 0xcf, 0x8a, 0x51, 0xf0, 0x96, 0x96, 0x52, 0x1e, 0x35, 0xe0, 0xbf,
+                       0x37, 0x99, 0x14, 0x0e, 0xdf, 0x08, 0xe8, 0x67, 0x62, 0xd1, 0x9b, 0x47, 0x7d, 0xd8, 0xd6, 0x28 };
+#endif
+    uint8_t out[64] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+                        0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+                        0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+    struct AES_HCTR2_ctx ctx;
+
+    // Empty tweak, whole blocks
+    AES_HCTR2_init_ctx(&ctx, key);
+    AES_HCTR2_decrypt_buffer(&ctx, NULL, 0, ct, 64);
+
+    printf("HCTR2 decrypt: ");
+
+    if (0 == memcmp((char*) out, (char*) ct, 64)) {
+        printf("SUCCESS!\n");
+	return(0);
+    } else {
+        printf("FAILURE!\n");
+	return(1);
+    }
+}